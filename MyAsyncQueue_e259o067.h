@@ -0,0 +1,158 @@
+#ifndef __MYASYNCQUEUE_H__
+#define __MYASYNCQUEUE_H__
+
+#include <coroutine>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+#include "MyExecutor_e259o067.h"
+#include "MyQueue_e259o067.h"
+
+// requires C++20 coroutines
+
+// unbounded queue whose consumers are coroutines: auto x = co_await queue.pop();
+// a consumer that finds the queue empty is suspended, not blocked; the producer that
+// supplies its element hands it over directly and schedules it on the queue's executor
+// push, tryPop and close may be called from any thread
+
+template <typename DataType>
+class MyAsyncQueue
+{
+  public:
+
+    // the awaitable returned by pop(); resumes with the element, or with nothing once the
+    // queue is closed and drained
+    class PopAwaiter
+    {
+      public:
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        // returns false (do not suspend) if an element or the end of the queue is already available
+        bool await_suspend(std::coroutine_handle<> h)
+        {
+            std::lock_guard<std::mutex> guard(queue->lock);
+            if(!queue->items.empty()){
+                result.emplace(std::move(queue->items.front()));
+                queue->items.dequeue();
+                return false;
+            }
+            if(queue->closed)
+                return false;
+            handle = h;
+            queue->waiters.enqueue(this);
+            return true;
+        }
+
+        std::optional<DataType> await_resume()
+        {
+            return std::move(result);
+        }
+
+      private:
+        MyAsyncQueue* queue;
+        std::optional<DataType> result;
+        std::coroutine_handle<> handle;
+
+        explicit PopAwaiter(MyAsyncQueue* q) :
+            queue{q}
+        {
+            ;
+        }
+
+        friend class MyAsyncQueue<DataType>;
+    };
+
+    // constructor; suspended consumers are resumed on ex
+    explicit MyAsyncQueue(MyExecutor& ex) :
+        executor{ex},
+        closed{false}
+    {
+        ;
+    }
+
+    MyAsyncQueue(const MyAsyncQueue& rhs) = delete;
+    MyAsyncQueue& operator=(const MyAsyncQueue& rhs) = delete;
+
+    // inserts x into the queue, waking one suspended consumer if there is one (copy)
+    void push(const DataType& x)
+    {
+        DataType copy = x;
+        push(std::move(copy));
+    }
+
+    // inserts x into the queue, waking one suspended consumer if there is one (move)
+    void push(DataType && x)
+    {
+        PopAwaiter* w = nullptr;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if(waiters.empty()){
+                items.enqueue(std::move(x));
+                return;
+            }
+            w = waiters.front();
+            waiters.dequeue();
+            w->result.emplace(std::move(x));
+        }
+        executor.schedule(w->handle);
+    }
+
+    // removes the first element, suspending the caller until one is available
+    PopAwaiter pop()
+    {
+        return PopAwaiter{this};
+    }
+
+    // moves the first element into x without suspending; returns false if the queue is empty
+    bool tryPop(DataType& x)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if(items.empty())
+            return false;
+        x = std::move(items.front());
+        items.dequeue();
+        return true;
+    }
+
+    // marks the end of the stream; suspended consumers resume with an empty result,
+    // and later pops return an empty result once the remaining elements are drained
+    void close()
+    {
+        MyQueue<PopAwaiter*> woken;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            closed = true;
+            std::swap(woken, waiters);
+        }
+        while(!woken.empty()){
+            executor.schedule(woken.front()->handle);
+            woken.dequeue();
+        }
+    }
+
+    // returns the number of queued elements
+    size_t size()
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        return items.size();
+    }
+
+    // checks whether the queue is empty
+    bool empty()
+    {
+        return size() == 0;
+    }
+
+  private:
+    MyExecutor& executor;           // resumes the consumers woken by push and close
+    std::mutex lock;
+    MyQueue<DataType> items;        // elements waiting for a consumer
+    MyQueue<PopAwaiter*> waiters;   // consumers waiting for an element
+    bool closed;
+};
+
+#endif // __MYASYNCQUEUE_H__
@@ -4,6 +4,12 @@
 #include <iostream>
 #include <fstream>
 #include <cstdlib>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#include "MyVector_e259o067.h"
 
 enum TreeTravOrderType
 {
@@ -27,28 +33,43 @@ class MyBST
     {
         ComparableType element;
         size_t height;
+        size_t subtreeSize;     // the number of nodes in the subtree rooted here
         BinaryNode *left;
         BinaryNode *right;
+        BinaryNode *parent;     // nullptr at the root
         
         BinaryNode(const ComparableType & x, const size_t h, BinaryNode *l, BinaryNode *r) : 
             element{x}, 
             height{h},
+            subtreeSize{1 + (l != nullptr ? l->subtreeSize : 0) + (r != nullptr ? r->subtreeSize : 0)},
             left{l}, 
-            right{r} 
+            right{r},
+            parent{nullptr}
         { 
-            ;
+            adoptChildren();
         }
 
         BinaryNode(ComparableType && x, const size_t h, BinaryNode *l, BinaryNode *r) : 
             element{std::move(x)}, 
             height{h},
+            subtreeSize{1 + (l != nullptr ? l->subtreeSize : 0) + (r != nullptr ? r->subtreeSize : 0)},
             left{l},
-            right{r}
+            right{r},
+            parent{nullptr}
         {
-            ;
+            adoptChildren();
+        }
+
+        // points the parent links of both children at this node
+        void adoptChildren()
+        {
+            if(left != nullptr) left->parent = this;
+            if(right != nullptr) right->parent = this;
         }
     };
 
+    template <typename T> friend class MyParallelBST;
+
     BinaryNode *root;       // the root node
     size_t theSize;         // the number of data elements in the tree
 
@@ -57,8 +78,8 @@ class MyBST
     {
         // code begins
         if(t == nullptr) return nullptr;
-        if(t->left == nullptr) return t;
-        return findMin(t->left);
+        while(t->left != nullptr) t = t->left;
+        return t;
         // code ends
     }
 
@@ -67,8 +88,8 @@ class MyBST
     {
         // code begins
         if(t == nullptr) return nullptr;
-        if(t->right == nullptr) return t;
-        return findMin(t->right);
+        while(t->right != nullptr) t = t->right;
+        return t;
         // code ends
     }
 
@@ -103,22 +124,52 @@ class MyBST
         return (t == nullptr ? 0 : t->height);
     }
 
+    // returns the number of nodes in the subtree rooted at t
+    size_t subtreeSize(BinaryNode* t) const
+    {
+        return (t == nullptr ? 0 : t->subtreeSize);
+    }
+
+    // recomputes the subtree size of node t from its children
+    void updateSize(BinaryNode* t)
+    {
+        t->subtreeSize = subtreeSize(t->left) + subtreeSize(t->right) + 1;
+    }
+
+    // counts the data elements smaller than x (or no larger than x, if inclusive)
+    size_t countBelow(const ComparableType& x, const bool inclusive) const
+    {
+        size_t count = 0;
+        BinaryNode* t = root;
+        while(t != nullptr){
+            if(t->element < x || (inclusive && !(x < t->element))){
+                count += subtreeSize(t->left) + 1;
+                t = t->right;
+            }
+            else
+                t = t->left;
+        }
+        return count;
+    }
+
     // balances tree node t
     void balance(BinaryNode*& t)
     {
         // code begins
         if(t == nullptr) return;
         if(height(t->left) > 1 + height(t->right))
-            if(height(t->left->left) > height(t->left->right))
+            if(height(t->left->left) >= height(t->left->right))
                 rotateLeft(t);
             else
                 doubleRotateLeft(t);
         else if(height(t->right) > 1 + height(t->left))
-            if(height(t->right->right) > height(t->right->left))
+            if(height(t->right->right) >= height(t->right->left))
                 rotateRight(t);
             else
                 doubleRotateRight(t);
         t->height = std::max( height( t->left ), height( t->right ) ) + 1;
+        updateSize(t);
+        t->adoptChildren();
         // code ends
     }
     
@@ -129,8 +180,13 @@ class MyBST
         BinaryNode* k = t->left;
         t->left = k->right;
         k->right = t;
+        k->parent = t->parent;
+        t->adoptChildren();
+        k->adoptChildren();
         t->height = std::max(height(t->left), height(t->right)) + 1;
         k->height = std::max(height(k->left), t->height) + 1;
+        updateSize(t);
+        updateSize(k);
         t = k;
         // code ends
     }
@@ -142,8 +198,13 @@ class MyBST
         BinaryNode* k = t->right;
         t->right = k->left;
         k->left = t;
+        k->parent = t->parent;
+        t->adoptChildren();
+        k->adoptChildren();
         t->height = std::max(height(t->right), height(t->left)) + 1;
         k->height = std::max(height(k->right), t->height) + 1;
+        updateSize(t);
+        updateSize(k);
         t = k;
         // code ends
     }
@@ -216,12 +277,213 @@ class MyBST
         // code ends
     }
 
+    // builds a perfectly balanced tree from the strictly increasing items[lo, hi)
+    BinaryNode* buildSorted(const MyVector<ComparableType>& items, const size_t lo, const size_t hi) const
+    {
+        if(lo >= hi) return nullptr;
+        const size_t mid = lo + (hi - lo) / 2;
+        BinaryNode* l = buildSorted(items, lo, mid);
+        BinaryNode* r = buildSorted(items, mid + 1, hi);
+        return new BinaryNode(items[mid], std::max(height(l), height(r)) + 1, l, r);
+    }
+
+    // joins the trees l and r with the detached node k in between
+    // every element of l must be smaller than k->element, and every element of r larger
+    // descends the spine of the taller tree to a subtree of about the height of the shorter one,
+    // attaches there and rebalances on the way back up: O(|height(l) - height(r)| + 1)
+    BinaryNode* join(BinaryNode* l, BinaryNode* k, BinaryNode* r)
+    {
+        if(height(l) > height(r) + 1){
+            l->right = join(l->right, k, r);
+            balance(l);
+            return l;
+        }
+        if(height(r) > height(l) + 1){
+            r->left = join(l, k, r->left);
+            balance(r);
+            return r;
+        }
+        k->left = l;
+        k->right = r;
+        k->height = std::max(height(l), height(r)) + 1;
+        updateSize(k);
+        k->adoptChildren();
+        return k;
+    }
+
+    // detaches the largest node of the non-empty tree t into last; returns the remaining tree
+    BinaryNode* splitLast(BinaryNode* t, BinaryNode*& last)
+    {
+        if(t->right == nullptr){
+            last = t;
+            return t->left;
+        }
+        t->right = splitLast(t->right, last);
+        balance(t);
+        return t;
+    }
+
+    // joins the trees l and r, where every element of l is smaller than every element of r
+    BinaryNode* join(BinaryNode* l, BinaryNode* r)
+    {
+        if(l == nullptr) return r;
+        if(r == nullptr) return l;
+        BinaryNode* k = nullptr;
+        l = splitLast(l, k);
+        return join(l, k, r);
+    }
+
+    // splits the tree t into l (elements smaller than x) and r (elements larger than x)
+    // returns the detached node holding x, or nullptr if x is not in t
+    BinaryNode* split(BinaryNode* t, const ComparableType& x, BinaryNode*& l, BinaryNode*& r)
+    {
+        if(t == nullptr){
+            l = r = nullptr;
+            return nullptr;
+        }
+        BinaryNode* tl = t->left;
+        BinaryNode* tr = t->right;
+        BinaryNode* found;
+        if(x < t->element){
+            BinaryNode* m;
+            found = split(tl, x, l, m);
+            r = join(m, t, tr);
+        }
+        else if(t->element < x){
+            BinaryNode* m;
+            found = split(tr, x, m, r);
+            l = join(tl, t, m);
+        }
+        else{
+            l = tl;
+            r = tr;
+            t->left = t->right = nullptr;
+            found = t;
+        }
+        return found;
+    }
+
+    // runs two independent subproblems of a set operation one after the other
+    // MyParallelBST_e259o067.h supplies a fork that runs them on a MyForkJoinPool instead
+    struct SequentialFork
+    {
+        template <typename F1, typename F2>
+        void operator()(const size_t, F1&& f1, F2&& f2) const
+        {
+            f1();
+            f2();
+        }
+    };
+
+    // returns the union of the trees t1 and t2; consumes both
+    template <typename Fork>
+    BinaryNode* unionTrees(BinaryNode* t1, BinaryNode* t2, const Fork& fork)
+    {
+        if(t1 == nullptr) return t2;
+        if(t2 == nullptr) return t1;
+        BinaryNode *l2, *r2, *l, *r;
+        BinaryNode* dup = split(t2, t1->element, l2, r2);
+        delete dup;
+        BinaryNode* l1 = t1->left;
+        BinaryNode* r1 = t1->right;
+        fork(t1->subtreeSize + subtreeSize(l2) + subtreeSize(r2),
+            [&]{ l = unionTrees(l1, l2, fork); },
+            [&]{ r = unionTrees(r1, r2, fork); });
+        return join(l, t1, r);
+    }
+
+    // returns the intersection of the trees t1 and t2; consumes both
+    template <typename Fork>
+    BinaryNode* intersectTrees(BinaryNode* t1, BinaryNode* t2, const Fork& fork)
+    {
+        if(t1 == nullptr || t2 == nullptr){
+            clear(t1);
+            clear(t2);
+            return nullptr;
+        }
+        BinaryNode *l2, *r2, *l, *r;
+        BinaryNode* dup = split(t2, t1->element, l2, r2);
+        BinaryNode* l1 = t1->left;
+        BinaryNode* r1 = t1->right;
+        fork(t1->subtreeSize + subtreeSize(l2) + subtreeSize(r2),
+            [&]{ l = intersectTrees(l1, l2, fork); },
+            [&]{ r = intersectTrees(r1, r2, fork); });
+        if(dup != nullptr){
+            delete dup;
+            return join(l, t1, r);
+        }
+        delete t1;
+        return join(l, r);
+    }
+
+    // returns the elements of the tree t1 that are not in the tree t2; consumes both
+    template <typename Fork>
+    BinaryNode* differenceTrees(BinaryNode* t1, BinaryNode* t2, const Fork& fork)
+    {
+        if(t1 == nullptr || t2 == nullptr){
+            clear(t2);
+            return t1;
+        }
+        BinaryNode *l2, *r2, *l, *r;
+        BinaryNode* dup = split(t2, t1->element, l2, r2);
+        BinaryNode* l1 = t1->left;
+        BinaryNode* r1 = t1->right;
+        fork(t1->subtreeSize + subtreeSize(l2) + subtreeSize(r2),
+            [&]{ l = differenceTrees(l1, l2, fork); },
+            [&]{ r = differenceTrees(r1, r2, fork); });
+        if(dup != nullptr){
+            delete dup;
+            delete t1;
+            return join(l, r);
+        }
+        return join(l, t1, r);
+    }
+
+    // the set operations, with the two halves of every step run by fork
+    template <typename Fork>
+    void unionWith(MyBST && rhs, const Fork& fork)
+    {
+        if(this == &rhs) return;
+        resetRoot(unionTrees(root, rhs.root, fork));
+        rhs.root = nullptr;
+        rhs.theSize = 0;
+    }
+
+    template <typename Fork>
+    void intersectWith(MyBST && rhs, const Fork& fork)
+    {
+        if(this == &rhs) return;
+        resetRoot(intersectTrees(root, rhs.root, fork));
+        rhs.root = nullptr;
+        rhs.theSize = 0;
+    }
+
+    template <typename Fork>
+    void differenceWith(MyBST && rhs, const Fork& fork)
+    {
+        if(this == &rhs){
+            clear();
+            return;
+        }
+        resetRoot(differenceTrees(root, rhs.root, fork));
+        rhs.root = nullptr;
+        rhs.theSize = 0;
+    }
+
+    // makes t the whole tree and takes the size from it
+    void resetRoot(BinaryNode* t)
+    {
+        root = t;
+        if(root != nullptr) root->parent = nullptr;
+        theSize = subtreeSize(root);
+    }
+
     // clones the node t and returns the clone
     BinaryNode* clone(BinaryNode* t) const
     {
         if( t == nullptr ) return nullptr;
         else
-            return new BinaryNode{t->element, clone(t->left), clone(t->right)};
+            return new BinaryNode{t->element, t->height, clone(t->left), clone(t->right)};
     }
 
     // prints all data elements rooted at t pre-order
@@ -294,6 +556,141 @@ class MyBST
 
   public:
 
+    // bidirectional in-order iterator; the elements are read-only, since changing one in place
+    // could break the search order
+    // walks parent links, so a step needs no stack, allocation or I/O (amortized O(1))
+    // insert and remove invalidate iterators
+    class const_iterator
+    {
+      public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef ComparableType value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const ComparableType* pointer;
+        typedef const ComparableType& reference;
+
+        const_iterator() :
+            tree{nullptr},
+            node{nullptr}
+        {
+            ;
+        }
+
+        reference operator*() const
+        {
+            return node->element;
+        }
+
+        pointer operator->() const
+        {
+            return &node->element;
+        }
+
+        // moves to the in-order successor
+        const_iterator& operator++()
+        {
+            if(node->right != nullptr)
+                node = tree->findMin(node->right);
+            else{
+                BinaryNode* child = node;
+                node = node->parent;
+                while(node != nullptr && child == node->right){
+                    child = node;
+                    node = node->parent;
+                }
+            }
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            const_iterator old = *this;
+            ++(*this);
+            return old;
+        }
+
+        // moves to the in-order predecessor; end() moves to the largest element
+        const_iterator& operator--()
+        {
+            if(node == nullptr)
+                node = tree->findMax(tree->root);
+            else if(node->left != nullptr)
+                node = tree->findMax(node->left);
+            else{
+                BinaryNode* child = node;
+                node = node->parent;
+                while(node != nullptr && child == node->left){
+                    child = node;
+                    node = node->parent;
+                }
+            }
+            return *this;
+        }
+
+        const_iterator operator--(int)
+        {
+            const_iterator old = *this;
+            --(*this);
+            return old;
+        }
+
+        bool operator==(const const_iterator& rhs) const
+        {
+            return node == rhs.node;
+        }
+
+        bool operator!=(const const_iterator& rhs) const
+        {
+            return node != rhs.node;
+        }
+
+      private:
+        const MyBST* tree;      // the tree, needed to step back from end()
+        BinaryNode* node;       // the current node; nullptr is end()
+
+        const_iterator(const MyBST* t, BinaryNode* n) :
+            tree{t},
+            node{n}
+        {
+            ;
+        }
+
+        friend class MyBST;
+    };
+
+    typedef const_iterator iterator;
+
+    // a lazily evaluated half-open range of iterators, usable in a range-based for loop
+    class Range
+    {
+      public:
+        Range(const_iterator b, const_iterator e) :
+            first{b},
+            last{e}
+        {
+            ;
+        }
+
+        const_iterator begin() const
+        {
+            return first;
+        }
+
+        const_iterator end() const
+        {
+            return last;
+        }
+
+        bool empty() const
+        {
+            return first == last;
+        }
+
+      private:
+        const_iterator first;
+        const_iterator last;
+    };
+
     // default constructor
     MyBST() : 
         root{nullptr},
@@ -302,6 +699,23 @@ class MyBST
         ;
     }
 
+    // constructor from a set of data elements
+    // strictly increasing input is built directly into a balanced tree in O(n); any other input
+    // is inserted element by element
+    MyBST(const MyVector<ComparableType>& items) :
+        root{nullptr},
+        theSize{0}
+    {
+        bool sorted = true;
+        for(size_t i = 1; i < items.size() && sorted; ++i)
+            sorted = items[i - 1] < items[i];
+        if(sorted)
+            resetRoot(buildSorted(items, 0, items.size()));
+        else
+            for(size_t i = 0; i < items.size(); ++i)
+                insert(items[i]);
+    }
+
     // copy constructor
     MyBST(const MyBST& rhs) : 
         root{nullptr},
@@ -328,7 +742,7 @@ class MyBST
     const ComparableType& findMin() const
     {
         // code begins
-        findMin(root);
+        return findMin(root)->element;
         // code ends
     }
 
@@ -336,7 +750,7 @@ class MyBST
     const ComparableType& findMax( ) const
     {
         // code begins
-        findMax(root);
+        return findMax(root)->element;
         // code ends
     }
 
@@ -379,6 +793,7 @@ class MyBST
     {
         // code begins
         clear(root);
+        theSize = 0;
         // code ends
     }
 
@@ -387,6 +802,7 @@ class MyBST
     {
         // code begins
         insert(x, root);
+        root->parent = nullptr;
         // code ends
     }
 
@@ -395,6 +811,7 @@ class MyBST
     {
         // code begins
         insert(std::move(x), root);
+        root->parent = nullptr;
         // code ends
     }
 
@@ -403,6 +820,7 @@ class MyBST
     {
         // code begins
         remove(x, root);
+        if(root != nullptr) root->parent = nullptr;
         // code ends
     }
 
@@ -426,6 +844,160 @@ class MyBST
         // code ends
     }
 
+    // returns the number of data elements smaller than x
+    size_t rank(const ComparableType& x) const
+    {
+        return countBelow(x, false);
+    }
+
+    // returns the k-th smallest data element (k counts from 0)
+    const ComparableType& select(size_t k) const
+    {
+        if(k >= theSize)
+            throw std::out_of_range("MyBST::select: index out of range");
+        BinaryNode* t = root;
+        while(true){
+            size_t leftSize = subtreeSize(t->left);
+            if(k < leftSize)
+                t = t->left;
+            else if(k > leftSize){
+                k -= leftSize + 1;
+                t = t->right;
+            }
+            else
+                return t->element;
+        }
+    }
+
+    // returns the number of data elements x with lo <= x <= hi
+    size_t countRange(const ComparableType& lo, const ComparableType& hi) const
+    {
+        if(hi < lo) return 0;
+        return countBelow(hi, true) - countBelow(lo, false);
+    }
+
+    // returns an iterator to the smallest data element
+    const_iterator begin() const
+    {
+        return const_iterator(this, findMin(root));
+    }
+
+    // returns the past-the-end iterator
+    const_iterator end() const
+    {
+        return const_iterator(this, nullptr);
+    }
+
+    // returns an iterator to the first data element not smaller than x
+    const_iterator lower_bound(const ComparableType& x) const
+    {
+        BinaryNode* result = nullptr;
+        for(BinaryNode* t = root; t != nullptr; ){
+            if(t->element < x)
+                t = t->right;
+            else{
+                result = t;
+                t = t->left;
+            }
+        }
+        return const_iterator(this, result);
+    }
+
+    // returns an iterator to the first data element larger than x
+    const_iterator upper_bound(const ComparableType& x) const
+    {
+        BinaryNode* result = nullptr;
+        for(BinaryNode* t = root; t != nullptr; ){
+            if(x < t->element){
+                result = t;
+                t = t->left;
+            }
+            else
+                t = t->right;
+        }
+        return const_iterator(this, result);
+    }
+
+    // returns the range of data elements equal to x (at most one, as duplicates are not stored)
+    std::pair<const_iterator, const_iterator> equal_range(const ComparableType& x) const
+    {
+        return std::make_pair(lower_bound(x), upper_bound(x));
+    }
+
+    // returns the data elements x with lo <= x <= hi as a lazy range; nothing is copied
+    Range range(const ComparableType& lo, const ComparableType& hi) const
+    {
+        if(hi < lo) return Range(end(), end());
+        return Range(lower_bound(lo), upper_bound(hi));
+    }
+
+    // splits the tree into the elements smaller than x (moved to lower) and those larger than x
+    // (moved to upper) in O(log n); this tree is left empty
+    // returns whether x was in the tree; x itself is dropped
+    bool split(const ComparableType& x, MyBST& lower, MyBST& upper)
+    {
+        BinaryNode *l, *r;
+        BinaryNode* found = split(root, x, l, r);
+        delete found;
+        root = nullptr;
+        theSize = 0;
+        lower.clear();
+        upper.clear();
+        lower.resetRoot(l);
+        upper.resetRoot(r);
+        return found != nullptr;
+    }
+
+    // appends the elements of rhs, which must all be larger than those of this tree, in O(log n)
+    // rhs is left empty
+    void join(MyBST && rhs)
+    {
+        if(this == &rhs) return;
+        if(root != nullptr && rhs.root != nullptr && !(findMax(root)->element < findMin(rhs.root)->element))
+            throw std::invalid_argument("MyBST::join: the trees overlap");
+        resetRoot(join(root, rhs.root));
+        rhs.root = nullptr;
+        rhs.theSize = 0;
+    }
+
+    // the set operations below split rhs around the root of this tree, recurse on the two halves
+    // and join the results, which takes O(m log(n/m + 1)) work for trees of sizes m <= n; the nodes
+    // of rhs are reused or freed
+    // MyParallelBST_e259o067.h runs the same operations on a MyForkJoinPool
+
+    // adds the elements of rhs to this tree; rhs is left empty
+    void unionWith(MyBST && rhs)
+    {
+        unionWith(std::move(rhs), SequentialFork());
+    }
+
+    void unionWith(const MyBST& rhs)
+    {
+        unionWith(MyBST(rhs));
+    }
+
+    // keeps only the elements also in rhs; rhs is left empty
+    void intersectWith(MyBST && rhs)
+    {
+        intersectWith(std::move(rhs), SequentialFork());
+    }
+
+    void intersectWith(const MyBST& rhs)
+    {
+        intersectWith(MyBST(rhs));
+    }
+
+    // removes the elements that are in rhs; rhs is left empty
+    void differenceWith(MyBST && rhs)
+    {
+        differenceWith(std::move(rhs), SequentialFork());
+    }
+
+    void differenceWith(const MyBST& rhs)
+    {
+        differenceWith(MyBST(rhs));
+    }
+
     // finds the lowest common ancestor (LCA) of x and y
     // if x and y are both in the tree, return true and store their LCA in lca
     // otherwise, return false
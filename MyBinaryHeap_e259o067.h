@@ -5,56 +5,90 @@
 #include <cstdlib>
 
 #include "MyVector_e259o067.h"
+#include "MyDaryHeapLayout_e259o067.h"
 
 // ComparableType should be comparable (<, >, ==, >=, <= operators implemented)
 // ComparableType should also have +, +=, -, -= operators implemented to support priority adjustment
 
-template <typename ComparableType>
+// Arity is the number of children per node (2, 4 or 8); the array is 0-based, so the children of
+// node i are Arity*i+1 .. Arity*i+Arity and sit next to each other in memory
+// the array is a MyDaryHeapArray, which aligns every sibling group to a multiple of Arity slots from
+// a cache line boundary: when Arity*sizeof(ComparableType) divides the line size, one sibling group
+// is one cache line
+// a wider heap is shallower, which trades a few more comparisons per level in percolateDown
+// for fewer levels, i.e. fewer cache misses on large heaps
+
+template <typename ComparableType, size_t Arity = 2>
 class MyBinaryHeap 
 {
+    static_assert(Arity == 2 || Arity == 4 || Arity == 8, "MyBinaryHeap supports arity 2, 4 or 8");
+
+    typedef MyDaryHeapLayout<Arity> Layout;
+
   private:
-	MyVector<ComparableType> data;  // the array that holds the data elements
+	MyDaryHeapArray<ComparableType, Arity> data;  // the array that holds the data elements
+
+    // returns the position of the parent of the node at position i
+    static size_t parentOf(const size_t i)
+    {
+        return Layout::parentOf(i);
+    }
+
+    // appends the elements of items (moved out of it if Move) and restores the heap property
+    // a small batch is sifted up element by element; a batch large enough that k sifts would cost
+    // more than one O(n) rebuild is appended and the whole array is re-heapified
+    template <bool Move, typename Items>
+    void appendBatch(Items& items)
+    {
+        const size_t k = items.size();
+        const bool rebuild = preferRebuild(k);
+        for(size_t i=0; i<k; ++i){
+            if constexpr (Move) data.push_back(std::move(items[i]));
+            else data.push_back(items[i]);
+            if(!rebuild) percolateUp(size() - 1);
+        }
+        if(rebuild) buildHeap();
+    }
 
     // moves the data element at the pth position of the array up
     void percolateUp(const size_t p) 
     {
         // code begins
-        size_t hole = p;
-        ComparableType temp = std::move(data[p]);
-        while(temp > data[hole/2]){
-            if(hole/2 < 1) break;
-            data[hole] = std::move(data[hole/2]);
-            hole /= 2;
-        }
-        data[hole] = std::move(temp);
+        Layout::percolateUp(data, p,
+            [](const ComparableType& x, const ComparableType& y){ return x > y; },
+            [this](const size_t i, ComparableType && x){ data[i] = std::move(x); });
         // code ends
     }
 
     // moves the data element at the pth position of the array down
-    void percolateDown(const size_t p) 
-    {
-        // code begins
-        size_t parent = p;
-        size_t child;
-        ComparableType temp = std::move(data[p]);
-        for(; parent*2 <= size(); parent = child){
-            child = parent*2;
-            if(child != size() && data[child+1] > data[child])
-                ++child;
-            if(data[child] > temp)
-                data[parent] = std::move(data[child]);
-            else break;
-        }
-        data[parent] = std::move(temp);
+    // only the first n positions of the array are treated as the heap
+    void percolateDown(const size_t p, const size_t n) 
+    {
+        // code begins
+        Layout::percolateDown(data, p, n,
+            [](const ComparableType& x, const ComparableType& y){ return x > y; },
+            [this](const size_t i, ComparableType && x){ data[i] = std::move(x); });
         // code ends
     }
 
+    // checks whether inserting a batch of k elements is cheaper by re-heapifying the whole array
+    // (O(n + k)) than by sifting each element up (O(k log(n + k)) in the worst case)
+    bool preferRebuild(const size_t k)
+    {
+        size_t total = size() + k;
+        size_t depth = 1;
+        for(size_t levelEnd = 1; levelEnd < total; levelEnd = levelEnd*Arity + 1)
+            ++depth;
+        return k*depth > total;
+    }
+
     // reorders the data elements in the array to ensure heap property
     void buildHeap() 
     {
         // code begins
-        for(int i = data.size()/2; i>0; --i)
-            percolateDown(i);
+        if(data.size() < 2) return;
+        for(size_t i = parentOf(data.size() - 1) + 1; i > 0; --i)
+            percolateDown(i - 1, data.size());
         // code ends
     }	
 
@@ -62,7 +96,7 @@ class MyBinaryHeap
 
     // default constructor
     explicit MyBinaryHeap() :
-        data(1)     // reserve data[0]
+        data()
     {
         // code begins
 
@@ -71,17 +105,18 @@ class MyBinaryHeap
 
     // constructor from a set of data elements
     MyBinaryHeap(const MyVector<ComparableType>& items) : 
-        data(1)     // reserve data[0]
+        data()
     {
         // code begins
+        data.reserve(items.size());
         for(size_t i=0; i<items.size(); ++i)
-            data[i+1] = items[i];
+            data.push_back(items[i]);
         buildHeap();
         // code ends
     }
 
     // copy constructor
-    MyBinaryHeap(const MyBinaryHeap<ComparableType>& rhs)
+    MyBinaryHeap(const MyBinaryHeap& rhs)
     {
         // code begins
         data = rhs.data;
@@ -89,7 +124,7 @@ class MyBinaryHeap
     }
 
     // move constructor
-    MyBinaryHeap(MyBinaryHeap<ComparableType> && rhs)
+    MyBinaryHeap(MyBinaryHeap && rhs)
     {
         // code begins
         data = std::move(rhs.data);
@@ -97,17 +132,17 @@ class MyBinaryHeap
     }
 
     // copy assignment
-    MyBinaryHeap& operator=(const MyBinaryHeap<ComparableType>& rhs)   
+    MyBinaryHeap& operator=(const MyBinaryHeap& rhs)   
     {
         // code begins
-        MyBinaryHeap<ComparableType> copy = rhs;
+        MyBinaryHeap copy = rhs;
         std::swap(*this, copy);
         return *this;
         // code ends
     }
 
     // move assignment
-    MyBinaryHeap& operator=(MyBinaryHeap<ComparableType> && rhs)
+    MyBinaryHeap& operator=(MyBinaryHeap && rhs)
     {
         // code begins
         std::swap(data, rhs.data);
@@ -120,7 +155,7 @@ class MyBinaryHeap
     {
         // code begins
         data.push_back(x);
-        percolateUp(size());
+        percolateUp(size() - 1);
         // code ends
     } 
 
@@ -129,7 +164,7 @@ class MyBinaryHeap
     {
         // code begins
         data.push_back(std::move(x));
-        percolateUp(size());
+        percolateUp(size() - 1);
         // code ends
     }
 
@@ -137,7 +172,7 @@ class MyBinaryHeap
 	const ComparableType& front()
     {
         // code begins
-        return data[1];
+        return data[0];
         // code ends
     } 
 
@@ -146,9 +181,9 @@ class MyBinaryHeap
     {
         // code begins
         if(empty()) return;
-        data[1] = std::move(data.back());
+        data[0] = std::move(data[size() - 1]);
         data.pop_back();
-        percolateDown(1);
+        if(!empty()) percolateDown(0, size());
         // code ends
     }
 
@@ -156,10 +191,8 @@ class MyBinaryHeap
     bool verifyHeapProperty(void)
     {
         // code begins
-        for (size_t i=1; i<=size()/2; i++){
-            if(data[2*i] > data[i]) 
-                return false;
-            if(data[2*i+1] > data[i]) 
+        for (size_t i=1; i<size(); i++){
+            if(data[i] > data[parentOf(i)]) 
                 return false;
         }
         return true;
@@ -169,35 +202,104 @@ class MyBinaryHeap
     // disrupts heap property by random shuffling
     void disruptHeapProperty(void)
     {
-        if(data.size() <= 3)
+        if(data.size() <= 2)
             return;
         for(size_t i = 0; i < 1000; ++ i)
         {
-            size_t p = 1 + ((int) rand()) % (data.size() - 1);
-            size_t q = 1 + ((int) rand()) % (data.size() - 1);
+            size_t p = ((int) rand()) % data.size();
+            size_t q = ((int) rand()) % data.size();
             std::swap(data[p], data[q]);
         }
         return;
     }
 
-    // merges two heaps; the second heap can be destructed after the merge
-    MyBinaryHeap& merge(MyBinaryHeap<ComparableType> && rhs) 
+    // merges two heaps; the second heap is left empty
+    // the smaller heap's elements are moved into the larger heap's array
+    MyBinaryHeap& merge(MyBinaryHeap && rhs) 
     {
         // code begins
-        for(size_t i=1; i<=rhs.size(); i++){
-            data.push_back(rhs.data[i]);
-        }
-        buildHeap();
+        if(this == &rhs) return *this;
+        if(rhs.size() > size())
+            std::swap(data, rhs.data);
+        appendBatch<true>(rhs.data);
+        rhs.clear();
         return *this;
         // code ends
     }
 
+    // inserts a batch of data elements into the heap (copy)
+    // small batches are sifted up one by one, large ones appended and re-heapified
+    void enqueueRange(const MyVector<ComparableType>& items)
+    {
+        appendBatch<false>(items);
+    }
+
+    // inserts a batch of data elements into the heap (move)
+    void enqueueRange(MyVector<ComparableType> && items)
+    {
+        appendBatch<true>(items);
+    }
+
+    // removes the k data elements with the highest priority (or all, if fewer) and appends them
+    // to out in priority order; returns the number removed
+    size_t dequeueTopK(size_t k, MyVector<ComparableType>& out)
+    {
+        if(k > size()) k = size();
+        for(size_t i=0; i<k; ++i){
+            out.push_back(std::move(data[0]));
+            data[0] = std::move(data[size() - 1]);
+            data.pop_back();
+            if(!empty()) percolateDown(0, size());
+        }
+        return k;
+    }
+
+    // replaces the data element with the highest priority by x with a single sift
+    // equivalent to dequeue() followed by enqueue(x), at half the cost
+    void replaceTop(const ComparableType& x)
+    {
+        if(empty()){
+            enqueue(x);
+            return;
+        }
+        data[0] = x;
+        percolateDown(0, size());
+    }
+
+    void replaceTop(ComparableType && x)
+    {
+        if(empty()){
+            enqueue(std::move(x));
+            return;
+        }
+        data[0] = std::move(x);
+        percolateDown(0, size());
+    }
+
+    // sorts items in ascending order in place, using the heap layout of this class
+    // the elements are moved into the aligned heap array and back
+    static void heapSort(MyVector<ComparableType>& items)
+    {
+        MyBinaryHeap heap;
+        heap.data.reserve(items.size());
+        for(size_t i=0; i<items.size(); ++i)
+            heap.data.push_back(std::move(items[i]));
+        heap.buildHeap();
+        for(size_t end = heap.size(); end > 1; --end){
+            std::swap(heap.data[0], heap.data[end - 1]);
+            heap.percolateDown(0, end - 1);
+        }
+        for(size_t i=0; i<items.size(); ++i)
+            items[i] = std::move(heap.data[i]);
+    }
+
     // increases the priority measure of an element at a specific position and reorder the heap
+    // positions count from 1, as in print()
 	void increaseKey(const size_t p, const unsigned int d)
     {    
         // code begins
-        data[p] = data[p] + d;
-        percolateUp(p);
+        data[p-1] = data[p-1] + d;
+        percolateUp(p-1);
         // code ends
     }
 
@@ -206,9 +308,9 @@ class MyBinaryHeap
 	void decreaseKey(const size_t p, const unsigned int d) 
     {
         // code begins
-        if(data[p] < d) data[p] = 0;
-        else data[p] = data[p] - d;
-        percolateDown(p);
+        if(data[p-1] < d) data[p-1] = 0;
+        else data[p-1] = data[p-1] - d;
+        percolateDown(p-1, size());
         // code ends   
     }
 
@@ -232,7 +334,7 @@ class MyBinaryHeap
     size_t size()
     {
         // code begins
-        return data.size() - 1;
+        return data.size();
         // code ends
     }
 
@@ -240,7 +342,7 @@ class MyBinaryHeap
     void print() 
     {
         const char delim = '\t';
-        for (size_t i = 1; i < data.size(); ++ i) {
+        for (size_t i = 0; i < data.size(); ++ i) {
             std::cout << data[i] << delim;
         }
         std::cout << std::endl;
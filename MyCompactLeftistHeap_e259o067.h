@@ -0,0 +1,279 @@
+#ifndef __MYCOMPACTLEFTISTHEAP_H__
+#define __MYCOMPACTLEFTISTHEAP_H__
+
+#include <iostream>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+#include "MyVector_e259o067.h"
+
+// ComparableType should be comparable (<, >, ==, >=, <= operators implemented)
+// ComparableType should also have +, +=, -, -= operators implemented to support priority adjustment
+
+// array-backed leftist heap: the same max-heap as MyLeftistHeap, but every node lives in one
+// MyVector and links to its neighbours by 32-bit index, with an 8-bit null path length
+// (a leftist heap of n nodes has npl <= log2(n + 1)); on a 64-bit target a HeapNode of an int heap
+// is 20 bytes against 40 for MyLeftistHeap's pointer node, i.e. exactly half the memory per element,
+// and the node array holds no pointers, so it can be written out as is
+// freed slots are recycled; a Handle (the slot index) stays valid until its element is dequeued
+// merge(&&) appends the other heap's nodes with an index offset and melds the two roots
+
+template <typename ComparableType>
+class MyCompactLeftistHeap
+{
+  public:
+    typedef uint32_t Handle;
+    static constexpr Handle NIL = UINT32_MAX;
+
+    // definition of HeapNode
+    struct HeapNode
+    {
+        ComparableType data;
+        Handle left;
+        Handle right;
+        Handle parent;
+        uint8_t npl;
+    };
+
+  private:
+    MyVector<HeapNode> nodes;       // the node array, including freed slots
+    MyVector<Handle> freeSlots;     // freed slots available for reuse
+    MyVector<Handle> mergePath;     // scratch: the right-spine nodes visited by a merge
+    Handle root;                    // root of the heap tree
+    size_t theSize;                 // the number of data elements
+
+    // returns the null path length of node t; an empty subtree has -1
+    int nplOf(const Handle t) const
+    {
+        return (t == NIL) ? -1 : nodes[t].npl;
+    }
+
+    // returns a slot for a new leaf holding x
+    template <typename T>
+    Handle newNode(T && x)
+    {
+        Handle t;
+        if(!freeSlots.empty()){
+            t = freeSlots.back();
+            freeSlots.pop_back();
+            nodes[t].data = std::forward<T>(x);
+        }
+        else{
+            if(nodes.size() >= NIL)
+                throw std::length_error("MyCompactLeftistHeap: too many nodes for a 32-bit index");
+            nodes.push_back(HeapNode{std::forward<T>(x), NIL, NIL, NIL, 0});
+            t = (Handle)(nodes.size() - 1);
+        }
+        nodes[t].left = nodes[t].right = nodes[t].parent = NIL;
+        nodes[t].npl = 0;
+        return t;
+    }
+
+    // merges the two trees rooted at r1 and r2; the result is a root (no parent)
+    Handle merge(Handle r1, Handle r2)
+    {
+        if(r1 == NIL || r2 == NIL){
+            Handle r = (r1 == NIL) ? r2 : r1;
+            if(r != NIL) nodes[r].parent = NIL;
+            return r;
+        }
+        if(!(nodes[r1].data > nodes[r2].data)) std::swap(r1, r2);
+        Handle top = r1;
+        nodes[top].parent = NIL;
+        mergePath.resize(0);
+        while(true){
+            // r1 is the larger root; r2 goes into its right subtree
+            mergePath.push_back(r1);
+            Handle r = nodes[r1].right;
+            if(nodes[r1].left == NIL || r == NIL){
+                if(nodes[r1].left == NIL) nodes[r1].left = r2;
+                else nodes[r1].right = r2;
+                nodes[r2].parent = r1;
+                break;
+            }
+            if(!(nodes[r].data > nodes[r2].data)){
+                nodes[r1].right = r2;
+                nodes[r2].parent = r1;
+                std::swap(r, r2);
+            }
+            r1 = r;
+        }
+        for(size_t i = mergePath.size(); i > 0; --i){
+            HeapNode& t = nodes[mergePath[i - 1]];
+            if(nplOf(t.left) < nplOf(t.right)) std::swap(t.left, t.right);
+            t.npl = (uint8_t)(nplOf(t.right) + 1);
+        }
+        return top;
+    }
+
+    // restores the leftist topology and the null path lengths from node t up to the root
+    void fixNpl(Handle t)
+    {
+        while(t != NIL){
+            HeapNode& n = nodes[t];
+            if(nplOf(n.left) < nplOf(n.right)) std::swap(n.left, n.right);
+            uint8_t npl = (uint8_t)(nplOf(n.right) + 1);
+            if(n.npl == npl) break;
+            n.npl = npl;
+            t = n.parent;
+        }
+    }
+
+    // detaches the subtree rooted at t (not the root) from its parent
+    void cut(const Handle t)
+    {
+        Handle p = nodes[t].parent;
+        if(nodes[p].left == t) nodes[p].left = NIL;
+        else nodes[p].right = NIL;
+        nodes[t].parent = NIL;
+        fixNpl(p);
+    }
+
+  public:
+
+    // default constructor
+    MyCompactLeftistHeap() :
+        root{NIL},
+        theSize{0}
+    {
+        ;
+    }
+
+    // returns the data element with the highest priority
+    const ComparableType& front() const
+    {
+        return nodes[root].data;
+    }
+
+    // returns the handle of the data element with the highest priority
+    Handle frontHandle() const
+    {
+        return root;
+    }
+
+    // accesses the data element of a handle
+    const ComparableType& get(const Handle h) const
+    {
+        return nodes[h].data;
+    }
+
+    // inserts x into the priority queue (copy); returns its handle
+    Handle enqueue(const ComparableType& x)
+    {
+        Handle t = newNode(x);
+        root = merge(t, root);
+        theSize++;
+        return t;
+    }
+
+    // inserts x into the priority queue (move); returns its handle
+    Handle enqueue(ComparableType && x)
+    {
+        Handle t = newNode(std::move(x));
+        root = merge(t, root);
+        theSize++;
+        return t;
+    }
+
+    // deletes the data element with the highest priority from the queue
+    void dequeue()
+    {
+        if(empty()) return;
+        Handle old = root;
+        root = merge(nodes[old].left, nodes[old].right);
+        nodes[old].data = ComparableType();     // release the payload held by the freed slot
+        freeSlots.push_back(old);
+        theSize--;
+    }
+
+    // increases the priority measure of the data element at handle t
+    void increaseKey(const Handle t, const unsigned int d)
+    {
+        nodes[t].data = nodes[t].data + d;
+        if(t == root) return;
+        cut(t);
+        root = merge(root, t);
+    }
+
+    // decreases the priority measure of the data element at handle t
+    // if the current priority is smaller than the requested decrement, assign priority 0
+    void decreaseKey(const Handle t, const unsigned int d)
+    {
+        if(nodes[t].data < (ComparableType)d) nodes[t].data = 0;
+        else nodes[t].data = nodes[t].data - (ComparableType)d;
+        Handle children = merge(nodes[t].left, nodes[t].right);
+        nodes[t].left = nodes[t].right = NIL;
+        if(t == root)
+            nodes[t].npl = 0;
+        else
+            fixNpl(t);
+        root = merge(root, children);
+    }
+
+    // merges two heaps; the nodes of rhs are appended to this heap and rhs is left empty
+    // returns the offset to add to a handle of rhs to get its handle in this heap
+    Handle merge(MyCompactLeftistHeap && rhs)
+    {
+        if(this == &rhs || rhs.empty()) return 0;
+        if(nodes.size() + rhs.nodes.size() > NIL)
+            throw std::length_error("MyCompactLeftistHeap: too many nodes for a 32-bit index");
+        const Handle offset = (Handle)nodes.size();
+        for(size_t i = 0; i < rhs.nodes.size(); ++i){
+            HeapNode& n = rhs.nodes[i];
+            if(n.left != NIL) n.left += offset;
+            if(n.right != NIL) n.right += offset;
+            if(n.parent != NIL) n.parent += offset;
+            nodes.push_back(std::move(n));
+        }
+        for(size_t i = 0; i < rhs.freeSlots.size(); ++i)
+            freeSlots.push_back(rhs.freeSlots[i] + offset);
+        root = merge(root, rhs.root + offset);
+        theSize += rhs.theSize;
+        rhs.clear();
+        return offset;
+    }
+
+    // verifies whether the tree satisfies the heap property and leftist topology
+    bool verifyHeapProperty(void) const
+    {
+        if(root == NIL) return true;
+        MyVector<Handle> stack;
+        stack.push_back(root);
+        while(!stack.empty()){
+            Handle t = stack.back();
+            stack.pop_back();
+            const HeapNode& n = nodes[t];
+            if(nplOf(n.left) < nplOf(n.right)) return false;
+            if(n.npl != nplOf(n.right) + 1) return false;
+            if(n.parent != NIL && nodes[n.parent].data < n.data) return false;
+            if(n.left != NIL) stack.push_back(n.left);
+            if(n.right != NIL) stack.push_back(n.right);
+        }
+        return true;
+    }
+
+    // clears all data in the queue
+    void clear()
+    {
+        nodes = MyVector<HeapNode>();
+        freeSlots.resize(0);
+        root = NIL;
+        theSize = 0;
+    }
+
+    // checks of the heap is empty
+    bool empty() const
+    {
+        return theSize == 0;
+    }
+
+    // checks the size of the heap
+    size_t size() const
+    {
+        return theSize;
+    }
+
+};
+
+#endif // __MYCOMPACTLEFTISTHEAP_H__
@@ -0,0 +1,721 @@
+#ifndef __MYCONCURRENTSKIPLIST_H__
+#define __MYCONCURRENTSKIPLIST_H__
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <utility>
+
+// ComparableType should be comparable (<, > operators implemented)
+
+// lock-free ordered set based on the Herlihy-Shavit skip list
+// insert, remove and contains can be called concurrently from any number of threads
+// a node is logically removed by marking the low bit of its next pointers (top level down to level 0)
+// and physically unlinked by any thread that walks past it
+// removed nodes are freed by epoch-based reclamation: every operation, and every iterator that has
+// not reached the end, pins the global epoch while it may hold node pointers, and a removed node is
+// freed once the epoch has advanced twice past its removal, when no pinned reader can still reach it
+// the epoch cannot advance past a pinned thread, so the removed nodes waiting to be freed are those
+// removed while the slowest pinned thread was inside its operation: a thread preempted mid-operation
+// or a long-lived iterator delays reclamation (never correctness) until it unpins
+
+template <typename ComparableType>
+class MyConcurrentSkipList
+{
+  private:
+    static const int MAX_LEVEL = 24;            // the highest level index a node can reach
+    static const size_t CACHE_LINE = 64;
+    static const size_t RECLAIM_INTERVAL = 64;  // the number of removals between attempts to advance the epoch
+
+    struct SkipNode
+    {
+        ComparableType element;
+        int topLevel;
+        std::atomic<uintptr_t>* next;       // tagged successor pointers, one for each level 0..topLevel
+        std::atomic<int> checkOuts;         // the inserter and the remover each check out once
+        SkipNode* retiredNext;              // links the node into a limbo list once it is removed
+
+        SkipNode(const ComparableType & x, const int lv) :
+            element{x},
+            topLevel{lv},
+            next{new std::atomic<uintptr_t>[lv + 1]},
+            checkOuts{0},
+            retiredNext{nullptr}
+        {
+            ;
+        }
+
+        SkipNode(ComparableType && x, const int lv) :
+            element{std::move(x)},
+            topLevel{lv},
+            next{new std::atomic<uintptr_t>[lv + 1]},
+            checkOuts{0},
+            retiredNext{nullptr}
+        {
+            ;
+        }
+
+        ~SkipNode()
+        {
+            delete [] next;
+        }
+    };
+
+    // an announcement slot; a pinned thread publishes the epoch it pinned, 0 when the slot is free
+    struct alignas(CACHE_LINE) EpochSlot
+    {
+        std::atomic<uint64_t> epoch;
+        EpochSlot* next;
+    };
+
+    // pins the epoch for the duration of an operation
+    struct EpochGuard
+    {
+        EpochSlot* slot;
+
+        explicit EpochGuard(const MyConcurrentSkipList& list) :
+            slot{list.pin()}
+        {
+            ;
+        }
+
+        ~EpochGuard()
+        {
+            unpin(slot);
+        }
+    };
+
+    std::atomic<uintptr_t> head[MAX_LEVEL + 1];     // the head tower; holds no data element
+    std::atomic<size_t> theSize;                    // the number of data elements in the list
+    mutable std::atomic<EpochSlot*> slots;          // the announcement slots; grown on demand, freed on destruction
+    std::atomic<uint64_t> globalEpoch;              // starts at 1 so that 0 can mark a free slot
+    std::atomic<SkipNode*> limbo[3];                // the removed nodes not yet freed, by removal epoch modulo 3
+    std::atomic<size_t> retiredCount;               // the number of removals so far
+
+    // helpers for the tagged pointers
+    static SkipNode* getPtr(const uintptr_t p)
+    {
+        return reinterpret_cast<SkipNode*>(p & ~uintptr_t(1));
+    }
+
+    static bool isMarked(const uintptr_t p)
+    {
+        return (p & 1) != 0;
+    }
+
+    static uintptr_t tag(SkipNode* t, const bool mark = false)
+    {
+        return reinterpret_cast<uintptr_t>(t) | (mark ? 1 : 0);
+    }
+
+    // returns the successor slot of pred at level lv; a null pred means the head tower
+    std::atomic<uintptr_t>& nextOf(SkipNode* pred, const int lv)
+    {
+        return (pred == nullptr) ? head[lv] : pred->next[lv];
+    }
+
+    const std::atomic<uintptr_t>& nextOf(const SkipNode* pred, const int lv) const
+    {
+        return (pred == nullptr) ? head[lv] : pred->next[lv];
+    }
+
+    // draws a geometrically distributed level (p = 1/2)
+    static int randomLevel()
+    {
+        static thread_local std::minstd_rand gen{std::random_device{}()};
+        int lv = 0;
+        unsigned long bits = gen();
+        while((bits & 1) && lv < MAX_LEVEL){
+            ++lv;
+            bits >>= 1;
+            if(bits == 0) bits = gen();
+        }
+        return lv;
+    }
+
+    // claims a free slot announcing epoch e, or the current epoch if e is 0, and returns it
+    // a stale e only makes the pin more conservative
+    EpochSlot* pin(uint64_t e = 0) const
+    {
+        if(e == 0) e = globalEpoch.load(std::memory_order_seq_cst);
+        EpochSlot* s = slots.load(std::memory_order_acquire);
+        for(; s != nullptr; s = s->next){
+            uint64_t expected = 0;
+            if(s->epoch.load(std::memory_order_relaxed) == 0 &&
+               s->epoch.compare_exchange_strong(expected, e, std::memory_order_seq_cst))
+                break;
+        }
+        if(s == nullptr){
+            s = new EpochSlot;
+            s->epoch.store(e, std::memory_order_relaxed);
+            s->next = slots.load(std::memory_order_relaxed);
+            while(!slots.compare_exchange_weak(s->next, s, std::memory_order_seq_cst, std::memory_order_relaxed))
+                ;
+        }
+        // the announcement must be visible before any node pointer is read
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        return s;
+    }
+
+    // releases a slot claimed by pin
+    static void unpin(EpochSlot* s)
+    {
+        s->epoch.store(0, std::memory_order_seq_cst);
+    }
+
+    // deletes a chain of retired nodes
+    static void freeChain(SkipNode* t)
+    {
+        while(t != nullptr){
+            SkipNode* n = t->retiredNext;
+            delete t;
+            t = n;
+        }
+    }
+
+    // advances the global epoch if every pinned thread has announced the current one, and frees
+    // the nodes removed two epochs ago, which no pinned thread can reach any more
+    // the caller must be pinned, so the epoch cannot move on again before the freeing is done
+    void tryAdvance()
+    {
+        uint64_t e = globalEpoch.load(std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        for(EpochSlot* s = slots.load(std::memory_order_acquire); s != nullptr; s = s->next){
+            uint64_t v = s->epoch.load(std::memory_order_seq_cst);
+            if(v != 0 && v != e) return;
+        }
+        if(!globalEpoch.compare_exchange_strong(e, e + 1, std::memory_order_seq_cst))
+            return;
+        freeChain(limbo[(e + 2) % 3].exchange(nullptr, std::memory_order_acq_rel));
+    }
+
+    // puts a removed node, no longer reachable from the list, into the limbo list of the current epoch
+    void retire(SkipNode* t)
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::atomic<SkipNode*>& bag = limbo[globalEpoch.load(std::memory_order_seq_cst) % 3];
+        SkipNode* old = bag.load(std::memory_order_relaxed);
+        do{
+            t->retiredNext = old;
+        }while(!bag.compare_exchange_weak(old, t, std::memory_order_release, std::memory_order_relaxed));
+        if(retiredCount.fetch_add(1, std::memory_order_relaxed) % RECLAIM_INTERVAL == RECLAIM_INTERVAL - 1)
+            tryAdvance();
+    }
+
+    // called by the inserter and by the remover of node t once each, after their last link or unlink of t
+    // the second one retires the node; only then can no level of the list still reach it
+    void checkOut(SkipNode* t)
+    {
+        if(t->checkOuts.fetch_add(1, std::memory_order_acq_rel) == 1)
+            retire(t);
+    }
+
+    // locates the predecessors and successors of x on every level, unlinking marked nodes on the way
+    // returns true if an unmarked node holding x is found at level 0
+    bool find(const ComparableType& x, SkipNode** preds, SkipNode** succs)
+    {
+      retry:
+        SkipNode* pred = nullptr;
+        SkipNode* curr = nullptr;
+        for(int lv = MAX_LEVEL; lv >= 0; --lv){
+            curr = getPtr(nextOf(pred, lv).load(std::memory_order_acquire));
+            while(curr != nullptr){
+                uintptr_t succ = curr->next[lv].load(std::memory_order_acquire);
+                while(isMarked(succ)){
+                    uintptr_t expected = tag(curr);
+                    if(!nextOf(pred, lv).compare_exchange_strong(expected, tag(getPtr(succ)),
+                            std::memory_order_acq_rel, std::memory_order_acquire))
+                        goto retry;
+                    curr = getPtr(succ);
+                    if(curr == nullptr) break;
+                    succ = curr->next[lv].load(std::memory_order_acquire);
+                }
+                if(curr == nullptr || !(curr->element < x)) break;
+                pred = curr;
+                curr = getPtr(succ);
+            }
+            preds[lv] = pred;
+            succs[lv] = curr;
+        }
+        return curr != nullptr && !(x < curr->element);
+    }
+
+    // returns the unmarked node holding x, or nullptr; never writes shared memory
+    // the caller must be pinned
+    SkipNode* lookup(const ComparableType& x) const
+    {
+        const SkipNode* pred = nullptr;
+        SkipNode* curr = nullptr;
+        for(int lv = MAX_LEVEL; lv >= 0; --lv){
+            curr = getPtr(nextOf(pred, lv).load(std::memory_order_acquire));
+            while(curr != nullptr){
+                uintptr_t succ = curr->next[lv].load(std::memory_order_acquire);
+                if(isMarked(succ)){
+                    curr = getPtr(succ);
+                    continue;
+                }
+                if(!(curr->element < x)) break;
+                pred = curr;
+                curr = getPtr(succ);
+            }
+        }
+        return (curr != nullptr && !(x < curr->element)) ? curr : nullptr;
+    }
+
+    // links the upper levels of node t, which is already in the list at level 0
+    // stops early if t is removed concurrently
+    void linkTower(SkipNode* t, SkipNode** preds, SkipNode** succs)
+    {
+        for(int lv = 1; lv <= t->topLevel; ++lv){
+            while(true){
+                uintptr_t succ = t->next[lv].load(std::memory_order_acquire);
+                if(isMarked(succ)) return;
+                if(getPtr(succ) != succs[lv] &&
+                   !t->next[lv].compare_exchange_strong(succ, tag(succs[lv]),
+                        std::memory_order_acq_rel, std::memory_order_acquire))
+                    return;                         // the only competing writer is a remover
+                uintptr_t expected = tag(succs[lv]);
+                if(nextOf(preds[lv], lv).compare_exchange_strong(expected, tag(t),
+                        std::memory_order_acq_rel, std::memory_order_acquire))
+                    break;
+                find(t->element, preds, succs);
+                if(succs[0] != t) return;
+            }
+        }
+    }
+
+    // links a freshly allocated node t into the list; returns false if x already exists
+    bool insertNode(SkipNode* t)
+    {
+        EpochGuard guard(*this);
+        SkipNode* preds[MAX_LEVEL + 1];
+        SkipNode* succs[MAX_LEVEL + 1];
+        while(true){
+            if(find(t->element, preds, succs)){
+                delete t;
+                return false;
+            }
+            for(int lv = 0; lv <= t->topLevel; ++lv)
+                t->next[lv].store(tag(succs[lv]), std::memory_order_relaxed);
+            uintptr_t expected = tag(succs[0]);
+            if(!nextOf(preds[0], 0).compare_exchange_strong(expected, tag(t),
+                    std::memory_order_acq_rel, std::memory_order_acquire))
+                continue;
+            theSize.fetch_add(1, std::memory_order_relaxed);
+            break;
+        }
+        // the node is now logically in the set; build the rest of its tower
+        linkTower(t, preds, succs);
+        // a remover may have unlinked t before the last levels were linked; unlink those as well
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(isMarked(t->next[0].load(std::memory_order_acquire)))
+            find(t->element, preds, succs);
+        checkOut(t);
+        return true;
+    }
+
+    // frees every node, including the removed ones; must not run concurrently with other operations
+    void freeAll()
+    {
+        SkipNode* t = getPtr(head[0].load(std::memory_order_acquire));
+        while(t != nullptr){
+            uintptr_t succ = t->next[0].load(std::memory_order_relaxed);
+            if(!isMarked(succ)) delete t;           // marked nodes are owned by the limbo lists
+            t = getPtr(succ);
+        }
+        for(int i = 0; i < 3; ++i)
+            freeChain(limbo[i].exchange(nullptr, std::memory_order_acquire));
+        for(int lv = 0; lv <= MAX_LEVEL; ++lv)
+            head[lv].store(0, std::memory_order_relaxed);
+        theSize.store(0, std::memory_order_relaxed);
+    }
+
+  public:
+
+    // forward iterator over the data elements in ascending order
+    // iteration is weakly consistent: it never skips elements present for its whole duration,
+    // and may or may not observe elements inserted or removed while it runs
+    // an iterator pins the epoch until it reaches the end or is destroyed, so it stays valid even if
+    // its element is removed; keeping one alive delays the freeing of removed nodes
+    class const_iterator
+    {
+      public:
+        const_iterator() :
+            list{nullptr},
+            slot{nullptr},
+            current{nullptr}
+        {
+            ;
+        }
+
+        // the copy pins the same epoch as rhs, which protects the same nodes
+        const_iterator(const const_iterator& rhs) :
+            list{rhs.list},
+            slot{nullptr},
+            current{rhs.current}
+        {
+            if(rhs.slot != nullptr)
+                slot = list->pin(rhs.slot->epoch.load(std::memory_order_relaxed));
+        }
+
+        const_iterator(const_iterator && rhs) :
+            list{rhs.list},
+            slot{rhs.slot},
+            current{rhs.current}
+        {
+            rhs.slot = nullptr;
+            rhs.current = nullptr;
+        }
+
+        ~const_iterator()
+        {
+            release();
+        }
+
+        const_iterator& operator=(const_iterator rhs)
+        {
+            std::swap(list, rhs.list);
+            std::swap(slot, rhs.slot);
+            std::swap(current, rhs.current);
+            return *this;
+        }
+
+        const ComparableType& operator*() const
+        {
+            return current->element;
+        }
+
+        const ComparableType* operator->() const
+        {
+            return &current->element;
+        }
+
+        const_iterator& operator++()
+        {
+            current = skipMarked(getPtr(current->next[0].load(std::memory_order_acquire)));
+            if(current == nullptr) release();
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            const_iterator old = *this;
+            ++(*this);
+            return old;
+        }
+
+        bool operator==(const const_iterator& rhs) const
+        {
+            return current == rhs.current;
+        }
+
+        bool operator!=(const const_iterator& rhs) const
+        {
+            return !(*this == rhs);
+        }
+
+      private:
+        const MyConcurrentSkipList* list;
+        EpochSlot* slot;        // the pin protecting current and its successors; null once past the end
+        SkipNode* current;
+
+        // takes over the pin s and starts at node t
+        const_iterator(const MyConcurrentSkipList* l, EpochSlot* s, SkipNode* t) :
+            list{l},
+            slot{s},
+            current{t}
+        {
+            if(current == nullptr) release();
+        }
+
+        // drops the pin
+        void release()
+        {
+            if(slot != nullptr){
+                unpin(slot);
+                slot = nullptr;
+            }
+        }
+
+        // advances past logically removed nodes
+        static SkipNode* skipMarked(SkipNode* t)
+        {
+            while(t != nullptr){
+                uintptr_t succ = t->next[0].load(std::memory_order_acquire);
+                if(!isMarked(succ)) break;
+                t = getPtr(succ);
+            }
+            return t;
+        }
+
+        friend class MyConcurrentSkipList<ComparableType>;
+    };
+
+    // default constructor
+    MyConcurrentSkipList() :
+        theSize{0},
+        slots{nullptr},
+        globalEpoch{1},
+        retiredCount{0}
+    {
+        for(int lv = 0; lv <= MAX_LEVEL; ++lv)
+            head[lv].store(0, std::memory_order_relaxed);
+        for(int i = 0; i < 3; ++i)
+            limbo[i].store(nullptr, std::memory_order_relaxed);
+    }
+
+    // the list is shared by address between threads; copying or moving it is not supported
+    MyConcurrentSkipList(const MyConcurrentSkipList& rhs) = delete;
+    MyConcurrentSkipList& operator=(const MyConcurrentSkipList& rhs) = delete;
+
+    // destructor
+    ~MyConcurrentSkipList()
+    {
+        freeAll();
+        EpochSlot* s = slots.load(std::memory_order_acquire);
+        while(s != nullptr){
+            EpochSlot* n = s->next;
+            delete s;
+            s = n;
+        }
+    }
+
+    // inserts x into the list (copy)
+    // returns true if x was not contained in the list; false otherwise
+    bool insert(const ComparableType& x)
+    {
+        return insertNode(new SkipNode(x, randomLevel()));
+    }
+
+    // inserts x into the list (move)
+    bool insert(ComparableType && x)
+    {
+        return insertNode(new SkipNode(std::move(x), randomLevel()));
+    }
+
+    // removes x from the list
+    // returns true if this call removed x; false if x was not contained in the list
+    bool remove(const ComparableType& x)
+    {
+        EpochGuard guard(*this);
+        SkipNode* preds[MAX_LEVEL + 1];
+        SkipNode* succs[MAX_LEVEL + 1];
+        if(!find(x, preds, succs))
+            return false;
+        SkipNode* victim = succs[0];
+        // mark the upper levels first so no new links to the victim can succeed
+        for(int lv = victim->topLevel; lv >= 1; --lv){
+            uintptr_t succ = victim->next[lv].load(std::memory_order_acquire);
+            while(!isMarked(succ))
+                victim->next[lv].compare_exchange_weak(succ, succ | 1,
+                    std::memory_order_acq_rel, std::memory_order_acquire);
+        }
+        // whoever marks level 0 owns the removal
+        uintptr_t succ = victim->next[0].load(std::memory_order_acquire);
+        while(!isMarked(succ)){
+            if(victim->next[0].compare_exchange_weak(succ, succ | 1,
+                    std::memory_order_acq_rel, std::memory_order_acquire)){
+                theSize.fetch_sub(1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                find(x, preds, succs);      // unlinks the victim on every level linked so far
+                checkOut(victim);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // checks whether x is contained in the list; never writes shared memory other than the epoch slots
+    bool contains(const ComparableType& x) const
+    {
+        EpochGuard guard(*this);
+        return lookup(x) != nullptr;
+    }
+
+    // returns an iterator to x, or end() if x is not contained in the list
+    const_iterator find(const ComparableType& x) const
+    {
+        EpochSlot* s = pin();
+        return const_iterator(this, s, lookup(x));
+    }
+
+    // frees the removed nodes that no thread can reach any more; safe to call concurrently
+    // removals already do this every RECLAIM_INTERVAL calls, so it is only needed to release
+    // memory promptly after a burst of removals
+    void reclaim()
+    {
+        for(int i = 0; i < 3; ++i){
+            EpochGuard guard(*this);        // pinned anew each time, at the epoch just reached
+            tryAdvance();
+        }
+    }
+
+    // returns the number of data elements in the list
+    // the value is exact only when no update is in flight
+    size_t size() const
+    {
+        return theSize.load(std::memory_order_relaxed);
+    }
+
+    // checks whether the list is empty
+    bool empty() const
+    {
+        return begin() == end();
+    }
+
+    // removes all data elements and frees removed nodes
+    // must not run concurrently with any other operation on the list
+    void clear()
+    {
+        freeAll();
+    }
+
+    // iterator to the smallest data element
+    const_iterator begin() const
+    {
+        EpochSlot* s = pin();
+        return const_iterator(this, s, const_iterator::skipMarked(getPtr(head[0].load(std::memory_order_acquire))));
+    }
+
+    // iterator past the largest data element
+    const_iterator end() const
+    {
+        return const_iterator();
+    }
+
+};
+
+// lock-free ordered map on top of MyConcurrentSkipList; the entries are ordered by key alone
+// a value is fixed once its entry is inserted, so readers can copy it out without locking;
+// to change the value of a key, remove the key and insert it again
+// KeyType should be comparable; ValueType should be default-constructible (lookups build a probe entry)
+
+template <typename KeyType, typename ValueType>
+class MyConcurrentSkipListMap
+{
+  public:
+    struct Entry
+    {
+        KeyType key;
+        ValueType value;
+
+        explicit Entry(const KeyType& k = KeyType{}) :
+            key{k},
+            value{}
+        {
+            ;
+        }
+
+        Entry(const KeyType& k, const ValueType& v) :
+            key{k},
+            value{v}
+        {
+            ;
+        }
+
+        Entry(KeyType && k, ValueType && v) :
+            key{std::move(k)},
+            value{std::move(v)}
+        {
+            ;
+        }
+
+        bool operator<(const Entry& rhs) const
+        {
+            return key < rhs.key;
+        }
+
+        bool operator>(const Entry& rhs) const
+        {
+            return rhs.key < key;
+        }
+    };
+
+    typedef typename MyConcurrentSkipList<Entry>::const_iterator const_iterator;
+
+  private:
+    MyConcurrentSkipList<Entry> entries;
+
+  public:
+
+    // inserts the entry (k, v) (copy)
+    // returns true if k was not contained in the map; false (and the map is unchanged) otherwise
+    bool insert(const KeyType& k, const ValueType& v)
+    {
+        return entries.insert(Entry(k, v));
+    }
+
+    // inserts the entry (k, v) (move)
+    bool insert(KeyType && k, ValueType && v)
+    {
+        return entries.insert(Entry(std::move(k), std::move(v)));
+    }
+
+    // removes the entry of key k; returns true if this call removed it
+    bool remove(const KeyType& k)
+    {
+        return entries.remove(Entry(k));
+    }
+
+    // checks whether key k is contained in the map
+    bool contains(const KeyType& k) const
+    {
+        return entries.contains(Entry(k));
+    }
+
+    // copies the value of key k into v; returns false if k is not contained in the map
+    bool get(const KeyType& k, ValueType& v) const
+    {
+        const_iterator it = entries.find(Entry(k));
+        if(it == entries.end())
+            return false;
+        v = it->value;
+        return true;
+    }
+
+    // returns an iterator to the entry of key k, or end() if k is not contained in the map
+    const_iterator find(const KeyType& k) const
+    {
+        return entries.find(Entry(k));
+    }
+
+    // frees the removed entries that no thread can reach any more; safe to call concurrently
+    void reclaim()
+    {
+        entries.reclaim();
+    }
+
+    // returns the number of entries in the map; exact only when no update is in flight
+    size_t size() const
+    {
+        return entries.size();
+    }
+
+    // checks whether the map is empty
+    bool empty() const
+    {
+        return entries.empty();
+    }
+
+    // removes all entries; must not run concurrently with any other operation on the map
+    void clear()
+    {
+        entries.clear();
+    }
+
+    // iterator to the entry with the smallest key
+    const_iterator begin() const
+    {
+        return entries.begin();
+    }
+
+    // iterator past the entry with the largest key
+    const_iterator end() const
+    {
+        return entries.end();
+    }
+
+};
+
+#endif // __MYCONCURRENTSKIPLIST_H__
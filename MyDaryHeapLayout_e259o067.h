@@ -0,0 +1,234 @@
+#ifndef __MYDARYHEAPLAYOUT_H__
+#define __MYDARYHEAPLAYOUT_H__
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+// memory layout of a d-ary heap in a 0-based array, where the children of node i are
+// Arity*i+1 .. Arity*i+Arity
+// MyDaryHeapArray starts its buffer on a cache line and leaves Arity-1 unused slots in front of
+// element 0, so every sibling group begins a multiple of Arity slots past the boundary; whenever
+// Arity*sizeof(DataType) divides the line size (8-ary of 8-byte keys, 4-ary of ints, ...) the
+// children of a node are read from a single cache line
+
+static const size_t DARY_CACHE_LINE = 64;
+
+// growable array for d-ary heap storage; the interface is the part of MyVector the heaps use
+// DataType should be default constructible, like MyVector
+template <typename DataType, size_t Arity>
+class MyDaryHeapArray
+{
+    static_assert(alignof(DataType) <= DARY_CACHE_LINE, "MyDaryHeapArray cannot over-align its elements");
+
+  private:
+    static const size_t LEAD = Arity - 1;   // unused slots in front of element 0
+
+    size_t theSize;                         // the number of data elements the array is currently holding
+    size_t theCapacity;                     // maximum data elements the array can hold
+    DataType* data;                         // address of element 0; the buffer starts LEAD slots earlier
+
+    // allocates a cache-line-aligned buffer of cap default-constructed elements after LEAD spare slots
+    static DataType* allocate(const size_t cap)
+    {
+        if(cap == 0) return nullptr;
+        char* raw = static_cast<char*>(::operator new((LEAD + cap) * sizeof(DataType), std::align_val_t(DARY_CACHE_LINE)));
+        DataType* p = reinterpret_cast<DataType*>(raw + LEAD * sizeof(DataType));
+        for(size_t i = 0; i < cap; ++i)
+            new (static_cast<void*>(p + i)) DataType();
+        return p;
+    }
+
+    // destroys the cap elements of a buffer made by allocate and frees it
+    static void release(DataType* p, const size_t cap)
+    {
+        if(p == nullptr) return;
+        for(size_t i = 0; i < cap; ++i)
+            p[i].~DataType();
+        ::operator delete(reinterpret_cast<char*>(p) - LEAD * sizeof(DataType), std::align_val_t(DARY_CACHE_LINE));
+    }
+
+  public:
+
+    // default constructor
+    MyDaryHeapArray() :
+        theSize{0},
+        theCapacity{0},
+        data{nullptr}
+    {
+        ;
+    }
+
+    // copy constructor
+    MyDaryHeapArray(const MyDaryHeapArray& rhs) :
+        theSize{rhs.theSize},
+        theCapacity{rhs.theSize},
+        data{allocate(rhs.theSize)}
+    {
+        for(size_t i = 0; i < theSize; ++i)
+            data[i] = rhs.data[i];
+    }
+
+    // move constructor
+    MyDaryHeapArray(MyDaryHeapArray && rhs) :
+        theSize{rhs.theSize},
+        theCapacity{rhs.theCapacity},
+        data{rhs.data}
+    {
+        rhs.data = nullptr;
+        rhs.theSize = 0;
+        rhs.theCapacity = 0;
+    }
+
+    // destructor
+    ~MyDaryHeapArray()
+    {
+        release(data, theCapacity);
+    }
+
+    // copy assignment
+    MyDaryHeapArray& operator=(const MyDaryHeapArray& rhs)
+    {
+        MyDaryHeapArray copy = rhs;
+        std::swap(*this, copy);
+        return *this;
+    }
+
+    // move assignment
+    MyDaryHeapArray& operator=(MyDaryHeapArray && rhs)
+    {
+        std::swap(theSize, rhs.theSize);
+        std::swap(theCapacity, rhs.theCapacity);
+        std::swap(data, rhs.data);
+        return *this;
+    }
+
+    // allocates more memory for the array
+    void reserve(const size_t newCapacity)
+    {
+        if(newCapacity <= theCapacity)
+            return;
+        DataType* newArray = allocate(newCapacity);
+        for(size_t i = 0; i < theSize; ++i)
+            newArray[i] = std::move(data[i]);
+        release(data, theCapacity);
+        data = newArray;
+        theCapacity = newCapacity;
+    }
+
+    // data access operator (without bound checking)
+    DataType& operator[](const size_t index)
+    {
+        return data[index];
+    }
+
+    const DataType& operator[](const size_t index) const
+    {
+        return data[index];
+    }
+
+    // inserts a data element at the end of the array
+    void push_back(const DataType& x)
+    {
+        if(theSize == theCapacity)
+            reserve(2*theCapacity + 16);
+        data[theSize++] = x;
+    }
+
+    void push_back(DataType && x)
+    {
+        if(theSize == theCapacity)
+            reserve(2*theCapacity + 16);
+        data[theSize++] = std::move(x);
+    }
+
+    // removes the last data element from the array
+    void pop_back()
+    {
+        --theSize;
+    }
+
+    // checks whether the array is empty
+    bool empty() const
+    {
+        return theSize == 0;
+    }
+
+    // returns the size of the array
+    size_t size() const
+    {
+        return theSize;
+    }
+};
+
+// index arithmetic of the d-ary layout
+template <size_t Arity>
+struct MyDaryHeapLayout
+{
+    static_assert(Arity == 2 || Arity == 4 || Arity == 8, "d-ary heaps support arity 2, 4 or 8");
+
+    // returns the position of the parent of the node at position i
+    static size_t parentOf(const size_t i)
+    {
+        return (i - 1) / Arity;
+    }
+
+    // returns the position of the first child of the node at position i
+    static size_t firstChild(const size_t i)
+    {
+        return Arity*i + 1;
+    }
+
+    // returns the position of the highest-priority child among the sibling group starting at first,
+    // counting only positions below n; higher(x, y) tells whether x has a higher priority than y
+    // a full sibling group has a compile-time trip count and a branch-free select, so the scan unrolls
+    // and vectorizes for arithmetic types
+    template <typename Array, typename Higher>
+    static size_t bestChild(const Array& a, const size_t first, const size_t n, Higher higher)
+    {
+        size_t best = first;
+        if(first + Arity <= n){
+            for(size_t c = first + 1; c < first + Arity; ++c)
+                best = higher(a[c], a[best]) ? c : best;
+        }
+        else{
+            for(size_t c = first + 1; c < n; ++c)
+                best = higher(a[c], a[best]) ? c : best;
+        }
+        return best;
+    }
+
+    // moves the element at position p of a up while it has a higher priority than its parent
+    // place(i, x) stores the element x at position i, so a heap can keep side tables (such as a
+    // position map) in step with every move
+    template <typename Array, typename Higher, typename Place>
+    static void percolateUp(Array& a, const size_t p, Higher higher, Place place)
+    {
+        size_t hole = p;
+        auto temp = std::move(a[p]);
+        while(hole > 0 && higher(temp, a[parentOf(hole)])){
+            place(hole, std::move(a[parentOf(hole)]));
+            hole = parentOf(hole);
+        }
+        place(hole, std::move(temp));
+    }
+
+    // moves the element at position p of a down while a child has a higher priority
+    // only the first n positions of a are treated as the heap; place is as in percolateUp
+    template <typename Array, typename Higher, typename Place>
+    static void percolateDown(Array& a, const size_t p, const size_t n, Higher higher, Place place)
+    {
+        size_t hole = p;
+        auto temp = std::move(a[p]);
+        while(firstChild(hole) < n){
+            size_t child = bestChild(a, firstChild(hole), n, higher);
+            if(higher(a[child], temp))
+                place(hole, std::move(a[child]));
+            else break;
+            hole = child;
+        }
+        place(hole, std::move(temp));
+    }
+};
+
+#endif // __MYDARYHEAPLAYOUT_H__
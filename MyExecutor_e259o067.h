@@ -0,0 +1,226 @@
+#ifndef __MYEXECUTOR_H__
+#define __MYEXECUTOR_H__
+
+#include <coroutine>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "MyQueue_e259o067.h"
+#include "MyVector_e259o067.h"
+
+// requires C++20 coroutines
+
+// a detached coroutine; it starts suspended and runs once it is handed to an executor with spawn()
+// the coroutine frame is freed automatically when the coroutine finishes
+class MyTask
+{
+  public:
+    struct promise_type
+    {
+        MyTask get_return_object()
+        {
+            return MyTask{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+
+        std::suspend_always initial_suspend() noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never final_suspend() noexcept
+        {
+            return {};
+        }
+
+        void return_void()
+        {
+            ;
+        }
+
+        void unhandled_exception()
+        {
+            std::terminate();
+        }
+    };
+
+    // move constructor
+    MyTask(MyTask && rhs) :
+        handle{rhs.handle}
+    {
+        rhs.handle = nullptr;
+    }
+
+    MyTask(const MyTask& rhs) = delete;
+    MyTask& operator=(const MyTask& rhs) = delete;
+
+    // destructor; a task that was never spawned is destroyed without running
+    ~MyTask()
+    {
+        if(handle)
+            handle.destroy();
+    }
+
+    // gives up ownership of the coroutine
+    std::coroutine_handle<> release()
+    {
+        std::coroutine_handle<> h = handle;
+        handle = nullptr;
+        return h;
+    }
+
+  private:
+    std::coroutine_handle<promise_type> handle;
+
+    explicit MyTask(std::coroutine_handle<promise_type> h) :
+        handle{h}
+    {
+        ;
+    }
+};
+
+// something that resumes suspended coroutines
+class MyExecutor
+{
+  public:
+    virtual ~MyExecutor()
+    {
+
+    }
+
+    // queues h to be resumed by the executor
+    virtual void schedule(std::coroutine_handle<> h) = 0;
+
+    // starts a task on the executor
+    void spawn(MyTask && t)
+    {
+        schedule(t.release());
+    }
+
+    // awaitable that moves the awaiting coroutine onto the executor: co_await ex.yield();
+    struct YieldAwaiter
+    {
+        MyExecutor* executor;
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> h)
+        {
+            executor->schedule(h);
+        }
+
+        void await_resume() const noexcept
+        {
+            ;
+        }
+    };
+
+    YieldAwaiter yield()
+    {
+        return YieldAwaiter{this};
+    }
+};
+
+// runs all coroutines on the thread that calls run(); not thread-safe
+class MyInlineExecutor : public MyExecutor
+{
+  private:
+    MyQueue<std::coroutine_handle<> > ready;    // coroutines waiting to be resumed
+
+  public:
+    // queues h to be resumed by run()
+    void schedule(std::coroutine_handle<> h) override
+    {
+        ready.enqueue(h);
+    }
+
+    // resumes coroutines until none is ready; returns the number of resumptions
+    size_t run()
+    {
+        size_t n = 0;
+        while(!ready.empty()){
+            std::coroutine_handle<> h = ready.front();
+            ready.dequeue();
+            h.resume();
+            ++n;
+        }
+        return n;
+    }
+};
+
+// resumes coroutines on a fixed set of worker threads sharing one ready queue
+class MyThreadPoolExecutor : public MyExecutor
+{
+  private:
+    std::mutex lock;
+    std::condition_variable wakeup;
+    MyQueue<std::coroutine_handle<> > ready;    // coroutines waiting to be resumed
+    MyVector<std::thread> workers;
+    bool stopping;
+
+    // the loop run by every worker thread
+    void workerLoop()
+    {
+        while(true){
+            std::coroutine_handle<> h;
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                wakeup.wait(guard, [this]{ return stopping || !ready.empty(); });
+                if(ready.empty())
+                    return;
+                h = ready.front();
+                ready.dequeue();
+            }
+            h.resume();
+        }
+    }
+
+  public:
+    // constructor; starts numThreads workers (at least one)
+    explicit MyThreadPoolExecutor(size_t numThreads = std::thread::hardware_concurrency()) :
+        stopping{false}
+    {
+        if(numThreads == 0)
+            numThreads = 1;
+        for(size_t i=0; i<numThreads; ++i)
+            workers.push_back(std::thread([this]{ workerLoop(); }));
+    }
+
+    MyThreadPoolExecutor(const MyThreadPoolExecutor& rhs) = delete;
+    MyThreadPoolExecutor& operator=(const MyThreadPoolExecutor& rhs) = delete;
+
+    // destructor; finishes the coroutines already queued, then joins the workers
+    ~MyThreadPoolExecutor()
+    {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stopping = true;
+        }
+        wakeup.notify_all();
+        for(size_t i=0; i<workers.size(); ++i)
+            workers[i].join();
+    }
+
+    // queues h to be resumed by one of the workers
+    void schedule(std::coroutine_handle<> h) override
+    {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            ready.enqueue(h);
+        }
+        wakeup.notify_one();
+    }
+
+    // returns the number of worker threads
+    size_t size() const
+    {
+        return workers.size();
+    }
+};
+
+#endif // __MYEXECUTOR_H__
@@ -0,0 +1,309 @@
+#ifndef __MYEXTERNALSORT_H__
+#define __MYEXTERNALSORT_H__
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <exception>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "MyBinaryHeap_e259o067.h"
+#include "MyForkJoinPool_e259o067.h"
+#include "MyVector_e259o067.h"
+
+// out-of-core sorting for files larger than memory
+//   1. the input is read in runs that fit the memory budget; each run is cut into one chunk per
+//      worker, the chunks are sorted in parallel and each chunk is written as its own run file
+//   2. the run files are k-way merged through a MyBinaryHeap of run cursors, in several passes
+//      if there are more runs than the fan-in limit
+// all file access goes through stdio streams with large buffers; an open, read or write failure
+// throws std::runtime_error, and the run files created so far are removed
+// the record format is a policy: MyBinaryRecordIO (fixed-size records) or MyTextRecordIO (lines)
+
+// fixed-size binary records; RecordType must be trivially copyable
+template <typename RecordType>
+struct MyBinaryRecordIO
+{
+    static_assert(std::is_trivially_copyable<RecordType>::value, "MyBinaryRecordIO requires a trivially copyable record");
+
+    static bool read(FILE* in, RecordType& r)
+    {
+        return fread(&r, sizeof(RecordType), 1, in) == 1;
+    }
+
+    static void write(FILE* out, const RecordType& r)
+    {
+        fwrite(&r, sizeof(RecordType), 1, out);
+    }
+
+    static size_t footprint(const RecordType&)
+    {
+        return sizeof(RecordType);
+    }
+};
+
+// newline-terminated text records, compared as strings
+struct MyTextRecordIO
+{
+    static bool read(FILE* in, std::string& r)
+    {
+        r.clear();
+        int c;
+        while((c = getc(in)) != EOF){
+            if(c == '\n')
+                return true;
+            r.push_back((char)c);
+        }
+        return !r.empty();      // a last line without a newline
+    }
+
+    static void write(FILE* out, const std::string& r)
+    {
+        fwrite(r.data(), 1, r.size(), out);
+        putc('\n', out);
+    }
+
+    static size_t footprint(const std::string& r)
+    {
+        return sizeof(std::string) + r.capacity();
+    }
+};
+
+template <typename RecordType, typename RecordIO = MyBinaryRecordIO<RecordType> >
+class MyExternalSorter
+{
+  private:
+    static const size_t IO_BUFFER = 1 << 20;    // the stdio buffer size of every stream
+
+    // a run being merged; MyBinaryHeap is a max-heap, so the ordering is reversed to surface
+    // the smallest head first, with ties broken by run number; runs are written with
+    // std::stable_sort and numbered in input order, so equal records keep their input order
+    struct RunCursor
+    {
+        RecordType head;
+        size_t run;
+
+        bool operator>(const RunCursor& rhs) const
+        {
+            if(head < rhs.head) return true;
+            if(rhs.head < head) return false;
+            return run < rhs.run;
+        }
+
+        bool operator<(const RunCursor& rhs) const
+        {
+            return rhs > *this;
+        }
+    };
+
+    size_t memoryBytes;         // the budget for one in-memory run
+    std::string tmpDir;         // where the run files go
+    MyForkJoinPool* pool;       // sorts the chunks of a run in parallel; may be null
+    size_t maxFanIn;            // the maximum number of runs merged at once
+    size_t runCounter;          // numbers the run files
+    MyVector<std::string> runFiles; // every run file created by the current sort
+
+    // closes the streams it holds when it goes out of scope, i.e. on the error paths
+    struct FileGuard
+    {
+        MyVector<FILE*> files;
+
+        ~FileGuard()
+        {
+            for(size_t i = 0; i < files.size(); ++i)
+                if(files[i] != nullptr)
+                    fclose(files[i]);
+        }
+    };
+
+    // removes every run file of the current sort when it goes out of scope
+    struct RunFileGuard
+    {
+        MyExternalSorter& sorter;
+
+        ~RunFileGuard()
+        {
+            for(size_t i = 0; i < sorter.runFiles.size(); ++i)
+                std::remove(sorter.runFiles[i].c_str());
+            sorter.runFiles.resize(0);
+        }
+    };
+
+    // opens a stdio stream with a large buffer; throws on failure
+    static FILE* openFile(const std::string& path, const char* mode)
+    {
+        FILE* f = fopen(path.c_str(), mode);
+        if(f == nullptr)
+            throw std::runtime_error("MyExternalSorter: cannot open " + path);
+        setvbuf(f, nullptr, _IOFBF, IO_BUFFER);
+        return f;
+    }
+
+    // closes a stream; throws if a read or write on it failed or the close itself fails
+    static void closeFile(FILE*& f, const std::string& path)
+    {
+        bool failed = ferror(f) != 0;
+        failed = (fclose(f) != 0) || failed;
+        f = nullptr;
+        if(failed)
+            throw std::runtime_error("MyExternalSorter: I/O error on " + path);
+    }
+
+    // returns a random tag drawn once per process, which keeps run names of different processes apart
+    static const std::string& processTag()
+    {
+        static const std::string tag = std::to_string(std::random_device{}() ^
+            (unsigned long long)std::chrono::steady_clock::now().time_since_epoch().count());
+        return tag;
+    }
+
+    // returns a fresh run file name, unique across sorters and processes sharing tmpDir
+    std::string newRunName()
+    {
+        runFiles.push_back(tmpDir + "/myextsort_" + processTag() + "_" + std::to_string((size_t)this) + "_" + std::to_string(runCounter++) + ".run");
+        return runFiles[runFiles.size() - 1];
+    }
+
+    // sorts records [lo, hi) and writes them to path
+    static void sortAndWrite(MyVector<RecordType>& records, const size_t lo, const size_t hi, const std::string& path)
+    {
+        std::stable_sort(records.begin() + lo, records.begin() + hi);
+        FileGuard out;
+        out.files.push_back(openFile(path, "wb"));
+        for(size_t i = lo; i < hi; ++i)
+            RecordIO::write(out.files[0], records[i]);
+        closeFile(out.files[0], path);
+    }
+
+    // sorts an in-memory run and appends the names of the resulting run files to runs
+    void flushRun(MyVector<RecordType>& records, MyVector<std::string>& runs)
+    {
+        const size_t n = records.size();
+        size_t chunks = (pool == nullptr) ? 1 : pool->size();
+        if(chunks > n) chunks = n;
+        if(chunks <= 1){
+            runs.push_back(newRunName());
+            sortAndWrite(records, 0, n, runs[runs.size() - 1]);
+        }
+        else{
+            const size_t first = runs.size();
+            for(size_t c = 0; c < chunks; ++c)
+                runs.push_back(newRunName());
+            // pool tasks must not throw: every chunk keeps its exception for rethrowing after sync
+            MyVector<std::exception_ptr> errors(chunks);
+            MyTaskGroup group(*pool);
+            for(size_t c = 0; c < chunks; ++c){
+                const size_t lo = n * c / chunks;
+                const size_t hi = n * (c + 1) / chunks;
+                const std::string* path = &runs[first + c];
+                std::exception_ptr* error = &errors[c];
+                group.spawn([&records, lo, hi, path, error]{
+                    try{
+                        sortAndWrite(records, lo, hi, *path);
+                    }
+                    catch(...){
+                        *error = std::current_exception();
+                    }
+                });
+            }
+            group.sync();
+            for(size_t c = 0; c < chunks; ++c)
+                if(errors[c])
+                    std::rethrow_exception(errors[c]);
+        }
+        records = MyVector<RecordType>();
+    }
+
+    // k-way merges the run files runs[lo, hi) into path and deletes them
+    void mergeRuns(const MyVector<std::string>& runs, const size_t lo, const size_t hi, const std::string& path)
+    {
+        const size_t k = hi - lo;
+        FileGuard inputs;
+        MyBinaryHeap<RunCursor> heap;
+        for(size_t i = 0; i < k; ++i){
+            inputs.files.push_back(openFile(runs[lo + i], "rb"));
+            RunCursor c;
+            c.run = i;
+            if(RecordIO::read(inputs.files[i], c.head))
+                heap.enqueue(std::move(c));
+        }
+        FileGuard out;
+        out.files.push_back(openFile(path, "wb"));
+        while(!heap.empty()){
+            RunCursor c = heap.front();
+            RecordIO::write(out.files[0], c.head);
+            if(RecordIO::read(inputs.files[c.run], c.head))
+                heap.replaceTop(std::move(c));
+            else
+                heap.dequeue();
+        }
+        closeFile(out.files[0], path);
+        for(size_t i = 0; i < k; ++i){
+            closeFile(inputs.files[i], runs[lo + i]);
+            std::remove(runs[lo + i].c_str());
+        }
+    }
+
+  public:
+
+    // constructor
+    // memory is the approximate number of bytes of records held in memory at once
+    // workers is an optional pool used to sort each run in parallel
+    explicit MyExternalSorter(size_t memory = 256 << 20, const std::string& tmp = ".", MyForkJoinPool* workers = nullptr, size_t fanIn = 64) :
+        memoryBytes{memory},
+        tmpDir{tmp},
+        pool{workers},
+        maxFanIn{fanIn < 2 ? 2 : fanIn},
+        runCounter{0}
+    {
+        ;
+    }
+
+    // sorts the records of inPath in ascending order into outPath
+    // returns the number of records sorted
+    size_t sort(const std::string& inPath, const std::string& outPath)
+    {
+        RunFileGuard cleanup{*this};
+
+        // phase 1: sorted runs
+        MyVector<std::string> runs;
+        size_t total = 0;
+        FileGuard input;
+        input.files.push_back(openFile(inPath, "rb"));
+        FILE* in = input.files[0];
+        MyVector<RecordType> records;
+        size_t bytes = 0;
+        RecordType r;
+        while(RecordIO::read(in, r)){
+            bytes += RecordIO::footprint(r);
+            records.push_back(std::move(r));
+            ++total;
+            if(bytes >= memoryBytes){
+                flushRun(records, runs);
+                bytes = 0;
+            }
+        }
+        closeFile(input.files[0], inPath);
+        if(!records.empty() || runs.empty())
+            flushRun(records, runs);
+
+        // phase 2: merge passes until a single run is left
+        while(runs.size() > maxFanIn){
+            MyVector<std::string> next;
+            for(size_t lo = 0; lo < runs.size(); lo += maxFanIn){
+                size_t hi = std::min(lo + maxFanIn, runs.size());
+                next.push_back(newRunName());
+                mergeRuns(runs, lo, hi, next[next.size() - 1]);
+            }
+            runs = std::move(next);
+        }
+        mergeRuns(runs, 0, runs.size(), outPath);
+        return total;
+    }
+
+};
+
+#endif // __MYEXTERNALSORT_H__
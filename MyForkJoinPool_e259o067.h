@@ -0,0 +1,238 @@
+#ifndef __MYFORKJOINPOOL_H__
+#define __MYFORKJOINPOOL_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <utility>
+
+#include "MyQueue_e259o067.h"
+#include "MyVector_e259o067.h"
+#include "MyWorkStealingDeque_e259o067.h"
+
+class MyTaskGroup;
+
+// work-stealing thread pool for fork/join parallelism
+// every worker owns a MyWorkStealingDeque: tasks it spawns go to its own bottom end, and an idle
+// worker steals from the top end of a random victim; tasks spawned from outside the pool go
+// through a small locked injection queue, which workers lock only when its atomic count says
+// it holds a task
+// the usual pattern is
+//     MyTaskGroup g(pool);
+//     g.spawn([&]{ left = solve(lo, mid); });
+//     right = solve(mid, hi);
+//     g.sync();
+// sync() executes other tasks while it waits, so nested fork/join never blocks a worker
+// tasks must not throw
+
+class MyForkJoinPool
+{
+  private:
+    struct Job
+    {
+        std::function<void()> fn;
+        MyTaskGroup* group;
+    };
+
+    MyVector<MyWorkStealingDeque<Job*>*> deques;    // one per worker
+    MyVector<std::thread> workers;
+    std::mutex injectLock;
+    MyQueue<Job*> injected;                         // tasks spawned from threads outside the pool
+    std::atomic<size_t> injectedCount;              // the length of injected; written under injectLock
+    std::atomic<size_t> queued;                     // the number of tasks waiting to run
+    std::atomic<size_t> sleepers;                   // the number of workers waiting on wakeup
+    std::mutex sleepLock;
+    std::condition_variable wakeup;
+    std::atomic<bool> stopping;
+
+    // the pool and worker index of the calling thread; null/0 outside any pool
+    static inline thread_local MyForkJoinPool* currentPool = nullptr;
+    static inline thread_local size_t currentIndex = 0;
+
+    // queues a job, preferring the calling worker's own deque
+    void submit(Job* job)
+    {
+        queued.fetch_add(1, std::memory_order_seq_cst);
+        if(currentPool == this)
+            deques[currentIndex]->push(job);
+        else{
+            std::lock_guard<std::mutex> guard(injectLock);
+            injected.enqueue(job);
+            injectedCount.fetch_add(1, std::memory_order_release);
+        }
+        if(sleepers.load(std::memory_order_seq_cst) > 0){
+            std::lock_guard<std::mutex> guard(sleepLock);
+            wakeup.notify_one();
+        }
+    }
+
+    // finds a job: own deque first, then the injection queue, then a random victim
+    Job* take()
+    {
+        Job* job = nullptr;
+        if(currentPool == this && deques[currentIndex]->pop(job))
+            return job;
+        if(injectedCount.load(std::memory_order_acquire) > 0){
+            std::lock_guard<std::mutex> guard(injectLock);
+            if(!injected.empty()){
+                job = injected.front();
+                injected.dequeue();
+                injectedCount.fetch_sub(1, std::memory_order_relaxed);
+                return job;
+            }
+        }
+        static thread_local std::minstd_rand gen{std::random_device{}()};
+        size_t n = deques.size();
+        size_t start = gen() % n;
+        for(size_t i=0; i<n; ++i){
+            MyWorkStealingDeque<Job*>* victim = deques[(start + i) % n];
+            if(victim->steal(job))
+                return job;
+        }
+        return nullptr;
+    }
+
+    // executes one job and signals its group
+    void execute(Job* job);
+
+    // the loop run by every worker thread
+    void workerLoop(const size_t index)
+    {
+        currentPool = this;
+        currentIndex = index;
+        while(!stopping.load(std::memory_order_acquire)){
+            if(runOne())
+                continue;
+            std::unique_lock<std::mutex> guard(sleepLock);
+            sleepers.fetch_add(1, std::memory_order_seq_cst);
+            wakeup.wait(guard, [this]{
+                return stopping.load(std::memory_order_acquire) || queued.load(std::memory_order_seq_cst) > 0;
+            });
+            sleepers.fetch_sub(1, std::memory_order_seq_cst);
+        }
+    }
+
+  public:
+
+    // constructor; starts numThreads workers (at least one)
+    explicit MyForkJoinPool(size_t numThreads = std::thread::hardware_concurrency()) :
+        injectedCount{0},
+        queued{0},
+        sleepers{0},
+        stopping{false}
+    {
+        if(numThreads == 0)
+            numThreads = 1;
+        for(size_t i=0; i<numThreads; ++i)
+            deques.push_back(new MyWorkStealingDeque<Job*>());
+        for(size_t i=0; i<numThreads; ++i)
+            workers.push_back(std::thread([this, i]{ workerLoop(i); }));
+    }
+
+    MyForkJoinPool(const MyForkJoinPool& rhs) = delete;
+    MyForkJoinPool& operator=(const MyForkJoinPool& rhs) = delete;
+
+    // destructor; every task group must have been synced before the pool is destroyed
+    ~MyForkJoinPool()
+    {
+        {
+            std::lock_guard<std::mutex> guard(sleepLock);
+            stopping.store(true, std::memory_order_release);
+        }
+        wakeup.notify_all();
+        for(size_t i=0; i<workers.size(); ++i)
+            workers[i].join();
+        for(size_t i=0; i<deques.size(); ++i)
+            delete deques[i];
+    }
+
+    // runs one queued job on the calling thread; returns false if none was found
+    bool runOne()
+    {
+        Job* job = take();
+        if(job == nullptr)
+            return false;
+        execute(job);
+        return true;
+    }
+
+    // runs fn in the pool and waits for it, helping with other tasks meanwhile
+    template <typename Func>
+    void run(Func&& fn);
+
+    // returns the number of worker threads
+    size_t size() const
+    {
+        return workers.size();
+    }
+
+    friend class MyTaskGroup;
+};
+
+// a set of tasks forked together and joined with sync()
+class MyTaskGroup
+{
+  private:
+    MyForkJoinPool& pool;
+    std::atomic<size_t> pending;    // the number of spawned tasks that have not finished
+
+    friend class MyForkJoinPool;
+
+  public:
+
+    // constructor
+    explicit MyTaskGroup(MyForkJoinPool& p) :
+        pool{p},
+        pending{0}
+    {
+        ;
+    }
+
+    MyTaskGroup(const MyTaskGroup& rhs) = delete;
+    MyTaskGroup& operator=(const MyTaskGroup& rhs) = delete;
+
+    // destructor; waits for the outstanding tasks
+    ~MyTaskGroup()
+    {
+        sync();
+    }
+
+    // forks fn as a task that any worker may run
+    template <typename Func>
+    void spawn(Func&& fn)
+    {
+        pending.fetch_add(1, std::memory_order_relaxed);
+        pool.submit(new MyForkJoinPool::Job{std::function<void()>(std::forward<Func>(fn)), this});
+    }
+
+    // waits until every task spawned in this group has finished, running queued tasks meanwhile
+    void sync()
+    {
+        while(pending.load(std::memory_order_acquire) > 0){
+            if(!pool.runOne())
+                std::this_thread::yield();
+        }
+    }
+};
+
+inline void MyForkJoinPool::execute(Job* job)
+{
+    queued.fetch_sub(1, std::memory_order_relaxed);
+    job->fn();
+    MyTaskGroup* group = job->group;
+    delete job;
+    group->pending.fetch_sub(1, std::memory_order_release);
+}
+
+template <typename Func>
+void MyForkJoinPool::run(Func&& fn)
+{
+    MyTaskGroup g(*this);
+    g.spawn(std::forward<Func>(fn));
+    g.sync();
+}
+
+#endif // __MYFORKJOINPOOL_H__
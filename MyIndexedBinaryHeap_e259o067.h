@@ -0,0 +1,243 @@
+#ifndef __MYINDEXEDBINARYHEAP_H__
+#define __MYINDEXEDBINARYHEAP_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "MyVector_e259o067.h"
+#include "MyDaryHeapLayout_e259o067.h"
+
+// ComparableType should be comparable (<, >, ==, >=, <= operators implemented)
+
+// addressable d-ary max-heap: enqueue returns a handle that keeps naming the same element
+// no matter how it moves, so its key can be changed or the element erased in O(log n)
+// the heap array holds slots only; a position map from slot to heap position is updated on
+// every move, and the keys stay put in a side array indexed by slot
+// the heap array and its sift loops come from MyDaryHeapLayout, as in MyBinaryHeap
+// a slot is recycled once its element leaves the heap; a handle carries the slot's generation in its
+// high 32 bits and the slot in its low 32 bits, so a stale handle never names the slot's next element
+
+template <typename ComparableType, size_t Arity = 2>
+class MyIndexedBinaryHeap
+{
+    static_assert(Arity == 2 || Arity == 4 || Arity == 8, "MyIndexedBinaryHeap supports arity 2, 4 or 8");
+
+    typedef MyDaryHeapLayout<Arity> Layout;
+
+  public:
+    typedef uint64_t Handle;
+    static constexpr size_t NPOS = (size_t)-1;
+
+  private:
+    MyDaryHeapArray<size_t, Arity> heap; // the heap array of slots
+    MyVector<size_t> pos;               // pos[s] is the heap position of slot s, or NPOS if s is free
+    MyVector<ComparableType> keys;      // keys[s] is the data element of slot s
+    MyVector<uint32_t> generation;      // bumped whenever slot s is freed, so stale handles are rejected
+    MyVector<size_t> freeSlots;         // slots available for reuse
+
+    // returns the position of the parent of the node at position i
+    static size_t parentOf(const size_t i)
+    {
+        return Layout::parentOf(i);
+    }
+
+    // tells whether the element of slot s has a higher priority than that of slot t
+    bool higher(const size_t s, const size_t t) const
+    {
+        return keys[s] > keys[t];
+    }
+
+    // stores slot s at heap position i
+    void place(const size_t i, const size_t s)
+    {
+        heap[i] = s;
+        pos[s] = i;
+    }
+
+    // builds the handle of slot s
+    Handle handleOf(const size_t s) const
+    {
+        return ((Handle)generation[s] << 32) | (Handle)s;
+    }
+
+    // decodes handle h; returns NPOS if it does not name an element in the heap
+    size_t slotOf(const Handle h) const
+    {
+        size_t s = (size_t)(h & 0xFFFFFFFFu);
+        if(s >= pos.size() || generation[s] != (uint32_t)(h >> 32) || pos[s] == NPOS)
+            return NPOS;
+        return s;
+    }
+
+    // moves the element at heap position p up
+    void percolateUp(const size_t p)
+    {
+        Layout::percolateUp(heap, p,
+            [this](const size_t s, const size_t t){ return higher(s, t); },
+            [this](const size_t i, const size_t s){ place(i, s); });
+    }
+
+    // moves the element at heap position p down
+    void percolateDown(const size_t p)
+    {
+        Layout::percolateDown(heap, p, heap.size(),
+            [this](const size_t s, const size_t t){ return higher(s, t); },
+            [this](const size_t i, const size_t s){ place(i, s); });
+    }
+
+    // restores the heap property for the element at heap position p after its key changed
+    void fix(const size_t p)
+    {
+        if(p > 0 && higher(heap[p], heap[parentOf(p)]))
+            percolateUp(p);
+        else
+            percolateDown(p);
+    }
+
+    // takes a free slot, or makes a new one
+    size_t newSlot()
+    {
+        if(!freeSlots.empty()){
+            size_t s = freeSlots.back();
+            freeSlots.pop_back();
+            return s;
+        }
+        pos.push_back(NPOS);
+        keys.push_back(ComparableType{});
+        generation.push_back(0);
+        return keys.size() - 1;
+    }
+
+    // removes the element at heap position p and recycles its slot
+    void removeAt(const size_t p)
+    {
+        size_t s = heap[p];
+        size_t last = heap[heap.size() - 1];
+        heap.pop_back();
+        pos[s] = NPOS;
+        keys[s] = ComparableType{};
+        ++generation[s];
+        freeSlots.push_back(s);
+        if(p < heap.size()){
+            place(p, last);
+            fix(p);
+        }
+    }
+
+  public:
+
+    // default constructor
+    MyIndexedBinaryHeap()
+    {
+        ;
+    }
+
+    // inserts x into the heap and returns its handle (copy)
+    Handle enqueue(const ComparableType& x)
+    {
+        size_t s = newSlot();
+        keys[s] = x;
+        heap.push_back(s);
+        pos[s] = heap.size() - 1;
+        percolateUp(heap.size() - 1);
+        return handleOf(s);
+    }
+
+    // inserts x into the heap and returns its handle (move)
+    Handle enqueue(ComparableType && x)
+    {
+        size_t s = newSlot();
+        keys[s] = std::move(x);
+        heap.push_back(s);
+        pos[s] = heap.size() - 1;
+        percolateUp(heap.size() - 1);
+        return handleOf(s);
+    }
+
+    // accesses the data element with the highest priority
+    const ComparableType& front() const
+    {
+        return keys[heap[0]];
+    }
+
+    // returns the handle of the data element with the highest priority
+    Handle frontHandle() const
+    {
+        return handleOf(heap[0]);
+    }
+
+    // deletes the data element with the highest priority from the heap
+    void dequeue()
+    {
+        if(empty()) return;
+        removeAt(0);
+    }
+
+    // checks whether handle h names an element currently in the heap
+    bool contains(const Handle h) const
+    {
+        return slotOf(h) != NPOS;
+    }
+
+    // accesses the data element named by handle h; h must name an element in the heap
+    const ComparableType& get(const Handle h) const
+    {
+        return keys[slotOf(h)];
+    }
+
+    // replaces the data element named by handle h with x and reorders the heap
+    // returns false if h does not name an element in the heap
+    bool update(const Handle h, const ComparableType& x)
+    {
+        size_t s = slotOf(h);
+        if(s == NPOS) return false;
+        keys[s] = x;
+        fix(pos[s]);
+        return true;
+    }
+
+    // removes the data element named by handle h from the heap
+    // returns false if h does not name an element in the heap
+    bool erase(const Handle h)
+    {
+        size_t s = slotOf(h);
+        if(s == NPOS) return false;
+        removeAt(pos[s]);
+        return true;
+    }
+
+    // verifies whether the array satisfies the heap property and the position map is consistent
+    bool verifyHeapProperty(void) const
+    {
+        for(size_t i=0; i<heap.size(); ++i){
+            if(pos[heap[i]] != i)
+                return false;
+            if(i > 0 && higher(heap[i], heap[parentOf(i)]))
+                return false;
+        }
+        return true;
+    }
+
+    // checks whether the heap is empty
+    bool empty() const
+    {
+        return heap.size() == 0;
+    }
+
+    // returns the size of the heap
+    size_t size() const
+    {
+        return heap.size();
+    }
+
+    // removes all data elements from the heap; every handle becomes stale
+    void clear()
+    {
+        while(!heap.empty())
+            removeAt(heap.size() - 1);
+    }
+
+};
+
+#endif // __MYINDEXEDBINARYHEAP_H__
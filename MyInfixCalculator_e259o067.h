@@ -2,10 +2,11 @@
 #define __MYINFIXCALCULATOR_H__
 
 #include <algorithm>
+#include <iostream>
 #include <string>
 
-#include "MyStack.h"
-#include "MyVector.h"
+#include "MyStaticStack_e259o067.h"
+#include "MyVector_e259o067.h"
 
 class MyInfixCalculator{
 
@@ -121,7 +122,7 @@ class MyInfixCalculator{
     // converts a set of infix tokens to a set of postfix tokens
     void infixToPostfix(MyVector<std::string>& infix_tokens, MyVector<std::string>& postfix_tokens)
     {
-        MyStack<char> stack;
+        MyStaticStack<char, 64, SpillToHeap> stack;
         for (size_t i=0; i<infix_tokens.size(); ++i) {
             char c = infix_tokens[i].back();
             if (isDigit(c))
@@ -156,7 +157,7 @@ class MyInfixCalculator{
     // calculates the final result from postfix tokens
     double calPostfix(const MyVector<std::string>& postfix_tokens) const
     {
-        MyStack<std::string> stack;
+        MyStaticStack<std::string, 16, SpillToHeap> stack;
         for(size_t i=0; i<postfix_tokens.size(); ++i){
             char c = postfix_tokens[i].back();
             if (isDigit(c))
@@ -3,11 +3,20 @@
 
 #include <iostream>
 #include <cstdlib>
+#include <memory>
+#include <new>
 #include <stdexcept>
 
+#include "MyVector_e259o067.h"
+
 // ComparableType should be comparable (<, >, ==, >=, <= operators implemented)
 // ComparableType should also have +, +=, -, -= operators implemented to support priority adjustment
 
+// nodes come from a per-heap arena: blocks of geometrically growing size plus a free list of
+// released nodes; merging with an rvalue heap adopts its blocks and free list in O(1), so its
+// nodes keep their addresses
+// merge, clear and clone are iterative, so a degenerate tree cannot overflow the call stack
+
 template <typename ComparableType>
 class MyLeftistHeap
 {
@@ -45,17 +54,52 @@ class MyLeftistHeap
     // default constructor
     MyLeftistHeap() :
         root{nullptr},
-        theSize(0)
+        theSize(0),
+        blocks{nullptr},
+        lastBlock{nullptr},
+        freeNodes{nullptr},
+        lastFree{nullptr},
+        nextBlockSize{MIN_BLOCK}
     {
         // code begins
 
         // code ends
     }
 
+    // constructor from a set of data elements
+    // melds single-node heaps pairwise, pass by pass; the passes halve the number of heaps and a
+    // meld costs O(log) of the heap sizes, so the whole build is O(n)
+    MyLeftistHeap(const MyVector<ComparableType>& items) :
+        root{nullptr},
+        theSize(items.size()),
+        blocks{nullptr},
+        lastBlock{nullptr},
+        freeNodes{nullptr},
+        lastFree{nullptr},
+        nextBlockSize{MIN_BLOCK}
+    {
+        if(items.empty()) return;
+        MyVector<HeapNode*> work(items.size());
+        for(size_t i = 0; i < items.size(); ++i)
+            work[i] = newNode(items[i]);
+        for(size_t n = work.size(); n > 1; n = (n + 1) / 2){
+            for(size_t i = 0; i < n / 2; ++i)
+                work[i] = merge(work[2*i], work[2*i + 1]);
+            if(n % 2 == 1)
+                work[n / 2] = work[n - 1];
+        }
+        root = work[0];
+    }
+
     // copy constructor
     MyLeftistHeap(const MyLeftistHeap& rhs) :
         root{nullptr},
-        theSize(rhs.theSize)
+        theSize(rhs.theSize),
+        blocks{nullptr},
+        lastBlock{nullptr},
+        freeNodes{nullptr},
+        lastFree{nullptr},
+        nextBlockSize{MIN_BLOCK}
     {
         // code begins
         root = clone(rhs.root);
@@ -65,10 +109,17 @@ class MyLeftistHeap
     // move constructor
     MyLeftistHeap(MyLeftistHeap && rhs) :
         root{rhs.root},
-        theSize(rhs.theSize)
+        theSize(rhs.theSize),
+        blocks{nullptr},
+        lastBlock{nullptr},
+        freeNodes{nullptr},
+        lastFree{nullptr},
+        nextBlockSize{MIN_BLOCK}
     {
         // code begins
         rhs.root = nullptr;
+        rhs.theSize = 0;
+        swapArena(rhs);
         // code ends
     }
 
@@ -96,6 +147,7 @@ class MyLeftistHeap
         // code begins
         std::swap(root, rhs.root);
         std::swap(theSize, rhs.theSize);
+        swapArena(rhs);
         return *this;
         // code ends
     }
@@ -112,7 +164,7 @@ class MyLeftistHeap
     void enqueue(const ComparableType& x)
     {
         // code begins
-        root = merge(new HeapNode{x}, root);
+        root = merge(newNode(x), root);
         theSize++;
         // code ends
     }
@@ -121,7 +173,7 @@ class MyLeftistHeap
     void enqueue(ComparableType && x)
     {
         // code begins
-        root = merge(new HeapNode{std::move(x)}, root);
+        root = merge(newNode(std::move(x)), root);
         theSize++;
         // code ends
     }
@@ -133,32 +185,42 @@ class MyLeftistHeap
         if(empty()) return;
         HeapNode *old = root;
         root = merge(root->left, root->right);
-        delete old;
+        deleteNode(old);
         theSize--;
         // code ends
     }
 
     // increases the priority measure of the data element locates at node t
+    // the subtree of t is cut off and melded back into the root; t stays a valid handle
 	void increaseKey(HeapNode *t, const unsigned int d)
     {
         // code begins
         t->data = t->data + d;
-        percolateUp(t);
+        if(t == root) return;
+        cut(t);
+        root = merge(root, t);
         // code ends
     }
 
     // decreases the priority measure of the data element locates at node t
     // if the current priority is smaller than the requested decrement, assign priority 0
+    // the children of t are cut off and melded back into the root; t stays a valid handle
 	void decreaseKey(HeapNode* t, const unsigned int d)
     {
         // code begins
         if(t->data < d) t->data = 0;
         else t->data = t->data - d;
-        percolateDown(t);
+        HeapNode* children = merge(t->left, t->right);
+        t->left = t->right = nullptr;
+        if(t == root)
+            t->npl = 0;
+        else
+            fixNpl(t);
+        root = merge(root, children);
         // code ends
     }
 
-    // merges two leftist heaps
+    // merges two leftist heaps; the nodes of rhs (and its arena) move into this heap
     void merge(MyLeftistHeap && rhs)
     {
         // code begins
@@ -167,6 +229,7 @@ class MyLeftistHeap
         theSize += rhs.theSize;
         rhs.root = nullptr;
         rhs.theSize = 0;
+        adoptArena(rhs);
         // code ends
     }
 
@@ -258,12 +321,13 @@ class MyLeftistHeap
         return;
     }
 
-    // clears all data in the queue
+    // clears all data in the queue and releases the node storage
     void clear()
     {
         // code begins
         clear(root);
         root = nullptr;
+        releaseArena();
         // code ends
     }
 
@@ -285,35 +349,159 @@ class MyLeftistHeap
 
   private:
 
+    static const size_t MIN_BLOCK = 16;     // the number of nodes in the first arena block
+    static const size_t MAX_BLOCK = 4096;   // the block size stops doubling here
+
+    // a chunk of node storage; nodes [0, used) have been handed out
+    struct NodeBlock
+    {
+        NodeBlock* next;
+        HeapNode* nodes;
+        size_t capacity;
+        size_t used;
+    };
+
+    // a released node, threaded through the storage of the node itself
+    struct FreeNode
+    {
+        FreeNode* next;
+    };
+
     HeapNode* root; // root of the heap tree
     size_t theSize; // the number of data elements
 
-    // merges the two trees rooted at r1 and r2, respectively
-    HeapNode* merge(HeapNode* r1, HeapNode* r2)
+    NodeBlock* blocks;          // the arena blocks; the first one is carved up next
+    NodeBlock* lastBlock;       // the tail of the block list, for O(1) adoption
+    FreeNode* freeNodes;        // released nodes available for reuse
+    FreeNode* lastFree;         // the tail of the free list, for O(1) adoption
+    size_t nextBlockSize;       // the capacity of the next block
+
+    MyVector<HeapNode*> mergePath;  // scratch: the right-spine nodes visited by a merge
+
+    // returns storage for one node
+    void* allocateNode()
     {
-        // code begins
-        if(r1 == nullptr) return r2;
-        if(r2 == nullptr) return r1;
-        if(r1->data > r2->data) return mergeSubtree(r1, r2);
-        else return mergeSubtree(r2, r1);
-        // code ends
+        if(freeNodes != nullptr){
+            FreeNode* f = freeNodes;
+            freeNodes = f->next;
+            if(freeNodes == nullptr) lastFree = nullptr;
+            return f;
+        }
+        if(blocks == nullptr || blocks->used == blocks->capacity){
+            NodeBlock* b = new NodeBlock{blocks, nullptr, nextBlockSize, 0};
+            b->nodes = std::allocator<HeapNode>().allocate(nextBlockSize);
+            if(blocks == nullptr) lastBlock = b;
+            blocks = b;
+            if(nextBlockSize < MAX_BLOCK) nextBlockSize *= 2;
+        }
+        return blocks->nodes + blocks->used++;
     }
 
-    // merges st (sub-tree) with the right subtree of mt (main-tree)
-    HeapNode* mergeSubtree(HeapNode* mt, HeapNode* st)
+    // creates a node holding x
+    template <typename T>
+    HeapNode* newNode(T && x)
+    {
+        return new (allocateNode()) HeapNode{std::forward<T>(x)};
+    }
+
+    // destroys node t and puts its storage on the free list
+    void deleteNode(HeapNode* t)
+    {
+        t->~HeapNode();
+        FreeNode* f = new (static_cast<void*>(t)) FreeNode{freeNodes};
+        if(freeNodes == nullptr) lastFree = f;
+        freeNodes = f;
+    }
+
+    // appends the blocks and free nodes of rhs to this arena
+    void adoptArena(MyLeftistHeap& rhs)
+    {
+        if(rhs.blocks != nullptr){
+            if(blocks == nullptr)
+                blocks = rhs.blocks;
+            else
+                lastBlock->next = rhs.blocks;
+            lastBlock = rhs.lastBlock;
+        }
+        if(rhs.freeNodes != nullptr){
+            if(freeNodes == nullptr)
+                freeNodes = rhs.freeNodes;
+            else
+                lastFree->next = rhs.freeNodes;
+            lastFree = rhs.lastFree;
+        }
+        if(rhs.nextBlockSize > nextBlockSize) nextBlockSize = rhs.nextBlockSize;
+        rhs.blocks = rhs.lastBlock = nullptr;
+        rhs.freeNodes = rhs.lastFree = nullptr;
+        rhs.nextBlockSize = MIN_BLOCK;
+    }
+
+    // exchanges the arenas of two heaps
+    void swapArena(MyLeftistHeap& rhs)
+    {
+        std::swap(blocks, rhs.blocks);
+        std::swap(lastBlock, rhs.lastBlock);
+        std::swap(freeNodes, rhs.freeNodes);
+        std::swap(lastFree, rhs.lastFree);
+        std::swap(nextBlockSize, rhs.nextBlockSize);
+    }
+
+    // returns every block; all nodes must have been destroyed
+    void releaseArena()
+    {
+        while(blocks != nullptr){
+            NodeBlock* next = blocks->next;
+            std::allocator<HeapNode>().deallocate(blocks->nodes, blocks->capacity);
+            delete blocks;
+            blocks = next;
+        }
+        lastBlock = nullptr;
+        freeNodes = lastFree = nullptr;
+        nextBlockSize = MIN_BLOCK;
+    }
+
+    // merges the two trees rooted at r1 and r2, respectively; the result is a root (no parent)
+    // walks down the right spines, splicing in the larger root at each step, then fixes the
+    // null path lengths bottom-up along the recorded path
+    HeapNode* merge(HeapNode* r1, HeapNode* r2)
     {
         // code begins
-        if(mt->left == nullptr){
-            mt->left = st;
-            mt->left->parent = mt;
+        if(r1 == nullptr || r2 == nullptr){
+            HeapNode* r = (r1 == nullptr) ? r2 : r1;
+            if(r != nullptr) r->parent = nullptr;
+            return r;
         }
-        else{
-            mt->right = merge(mt->right, st);
-            mt->right->parent = mt;
-            if(mt->left->npl < mt->right->npl) swapChildren(mt);
-            mt->npl = mt->right->npl + 1;
+        if(!(r1->data > r2->data)) std::swap(r1, r2);
+        HeapNode* top = r1;
+        top->parent = nullptr;
+        mergePath.resize(0);
+        while(true){
+            // r1 is the larger root; r2 goes into its right subtree
+            mergePath.push_back(r1);
+            HeapNode* r = r1->right;
+            if(r1->left == nullptr || r == nullptr){
+                if(r1->left == nullptr) r1->left = r2;
+                else r1->right = r2;
+                r2->parent = r1;
+                break;
+            }
+            if(!(r->data > r2->data)){
+                r1->right = r2;
+                r2->parent = r1;
+                std::swap(r, r2);
+            }
+            r1 = r;
         }
-        return mt;
+        for(size_t i = mergePath.size(); i > 0; --i){
+            HeapNode* t = mergePath[i - 1];
+            if(t->right == nullptr){
+                t->npl = 0;
+                continue;
+            }
+            if(t->left->npl < t->right->npl) swapChildren(t);
+            t->npl = t->right->npl + 1;
+        }
+        return top;
         // code ends
     }
 
@@ -326,74 +514,77 @@ class MyLeftistHeap
     }
 
     // deletes the subtree rooted at t
+    // rotates left children up until the top node has none, then deletes it and moves right,
+    // which visits every node with no stack
     void clear(HeapNode *t)
     {
         // code begins
-        if(t != nullptr){
-            clear(t->left);
-            clear(t->right);
-            delete t;
-            theSize--;
+        while(t != nullptr){
+            if(t->left != nullptr){
+                HeapNode* l = t->left;
+                t->left = l->right;
+                l->right = t;
+                t = l;
+            }
+            else{
+                HeapNode* next = t->right;
+                deleteNode(t);
+                theSize--;
+                t = next;
+            }
         }
-        t = nullptr;
         // code ends
     }
 
-    // clones the tree rooted at t; returns the root of the cloned tree
+    // clones the tree rooted at t into this heap's arena; returns the root of the cloned tree
     HeapNode* clone(HeapNode* t)
     {
         // code begins
         if(t == nullptr) return nullptr;
-        else{
-            HeapNode* copy = new HeapNode(t->data, nullptr, nullptr, nullptr, t->npl);
-            copy->left = clone(t->left);
-            if(copy->left != nullptr) copy->left->parent = copy;
-            copy->right = clone(t->right);
-            if(copy->right != nullptr) copy->right->parent = copy;
-            return copy;
+        HeapNode* top = new (allocateNode()) HeapNode(t->data, nullptr, nullptr, nullptr, t->npl);
+        MyVector<std::pair<HeapNode*, HeapNode*> > stack;   // (original, copy) pairs to expand
+        stack.push_back(std::make_pair(t, top));
+        while(!stack.empty()){
+            std::pair<HeapNode*, HeapNode*> p = stack.back();
+            stack.pop_back();
+            if(p.first->left != nullptr){
+                p.second->left = new (allocateNode()) HeapNode(p.first->left->data, nullptr, nullptr, p.second, p.first->left->npl);
+                stack.push_back(std::make_pair(p.first->left, p.second->left));
+            }
+            if(p.first->right != nullptr){
+                p.second->right = new (allocateNode()) HeapNode(p.first->right->data, nullptr, nullptr, p.second, p.first->right->npl);
+                stack.push_back(std::make_pair(p.first->right, p.second->right));
+            }
         }
+        return top;
         // code ends
     }
 
-    // percolates the node t up the heap
-    void percolateUp(HeapNode* t)
+    // restores the leftist topology and the null path lengths from node t up to the root
+    // after one of the subtrees of t shrank; stops as soon as a null path length is unchanged
+    void fixNpl(HeapNode* t)
     {
-        // code begins
-        if(t->parent == nullptr) return;
-        if(t->data > t->parent->data){
-            std::swap(t->data, t->parent->data);
-            percolateUp(t->parent);
+        while(t != nullptr){
+            int ln = (t->left != nullptr) ? t->left->npl : -1;
+            int rn = (t->right != nullptr) ? t->right->npl : -1;
+            if(ln < rn){
+                swapChildren(t);
+                rn = ln;
+            }
+            if(t->npl == rn + 1) break;
+            t->npl = rn + 1;
+            t = t->parent;
         }
-        // code ends
     }
 
-    // percolates the node t down the heap
-    void percolateDown(HeapNode* t)
+    // detaches the subtree rooted at t (not the root) from its parent
+    void cut(HeapNode* t)
     {
-        // code begins
-        if(t->left == nullptr && t->right == nullptr) return;
-        char path = 'n';
-        if(t->left != nullptr && t->right != nullptr){
-            if(t->left->data > t->data && t->left->data > t->right->data)
-                path = 'l';
-            else if(t->right->data > t->data && t->right->data > t->left->data)
-                path = 'r';
-        }
-        else if(t->left != nullptr && t->left->data > t->data) path = 'l';
-        else if(t->right != nullptr && t->right->data > t->data) path = 'r';
-        switch(path){
-            case 'l':
-                std::swap(t->data, t->left->data);
-                percolateDown(t->left);
-                break;
-            case 'r':
-                std::swap(t->data, t->right->data);
-                percolateDown(t->right);
-                break;
-            default:
-                return;
-        }
-        // code ends
+        HeapNode* p = t->parent;
+        if(p->left == t) p->left = nullptr;
+        else p->right = nullptr;
+        t->parent = nullptr;
+        fixNpl(p);
     }
 
     // verifies whether the subtree rooted at t satisfies the heap property and leftist topology
@@ -0,0 +1,242 @@
+#ifndef __MYMPMCQUEUE_H__
+#define __MYMPMCQUEUE_H__
+
+#include <atomic>
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+
+#include "MyVector_e259o067.h"
+
+// bounded lock-free multi-producer/multi-consumer queue (Vyukov's sequence-numbered ring)
+// every slot carries a sequence number telling whose turn it is:
+//   seq == pos        the slot is free for the producer that claims position pos
+//   seq == pos + 1    the slot holds the element for the consumer that claims position pos
+// a producer or consumer claims a position with one CAS and then owns the slot exclusively
+// there is no front(): with several consumers the head can be taken between a peek and a dequeue
+
+template <typename DataType>
+class MyMPMCQueue
+{
+  private:
+    static const size_t CACHE_LINE = 64;
+
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        DataType data;
+    };
+
+    alignas(CACHE_LINE) MyVector<Cell> ring;        // the slots; the capacity is a power of two
+    size_t mask;                                    // capacity - 1
+    alignas(CACHE_LINE) std::atomic<size_t> enqueuePos;
+    alignas(CACHE_LINE) std::atomic<size_t> dequeuePos;
+
+    // returns the smallest power of two that is at least n
+    static size_t roundUpPow2(size_t n)
+    {
+        size_t c = 2;
+        while(c < n)
+            c <<= 1;
+        return c;
+    }
+
+    // waits a little longer on every call; used by the blocking operations
+    // the kth call busy-waits 2^k iterations, and once that reaches 2^MAX_BACKOFF every call
+    // yields the processor instead
+    static const unsigned MAX_BACKOFF = 10;
+
+    static void backoff(unsigned& spins)
+    {
+        if(spins >= MAX_BACKOFF){
+            std::this_thread::yield();
+            return;
+        }
+        for(size_t i = size_t(1) << spins++; i > 0; --i)
+            std::atomic_signal_fence(std::memory_order_seq_cst);
+    }
+
+    // claims a run of up to n positions at the given end of the queue
+    // a slot is ready when its sequence equals pos + i + offset (offset 0 for producers, 1 for consumers)
+    // on success stores the first claimed position in first and returns the length of the run
+    size_t claim(std::atomic<size_t>& position, const size_t offset, size_t n, size_t& first)
+    {
+        if(n == 0) return 0;
+        size_t pos = position.load(std::memory_order_relaxed);
+        while(true){
+            size_t k = 0;
+            while(k < n){
+                Cell& cell = ring[(pos + k) & mask];
+                size_t seq = cell.sequence.load(std::memory_order_acquire);
+                if(seq != pos + k + offset) break;
+                ++k;
+            }
+            if(k == 0){
+                // either the queue is full/empty, or another thread advanced position under us
+                Cell& cell = ring[pos & mask];
+                size_t seq = cell.sequence.load(std::memory_order_acquire);
+                if((ptrdiff_t)(seq - (pos + offset)) < 0)
+                    return 0;
+                pos = position.load(std::memory_order_relaxed);
+                continue;
+            }
+            if(position.compare_exchange_weak(pos, pos + k, std::memory_order_relaxed))
+            {
+                first = pos;
+                return k;
+            }
+        }
+    }
+
+  public:
+
+    // constructor; the capacity is rounded up to a power of two
+    explicit MyMPMCQueue(size_t cap = 1024) :
+        ring(roundUpPow2(cap)),
+        enqueuePos{0},
+        dequeuePos{0}
+    {
+        mask = ring.size() - 1;
+        for(size_t i=0; i<ring.size(); ++i)
+            ring[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    // the queue is shared by address between threads; copying or moving it is not supported
+    MyMPMCQueue(const MyMPMCQueue& rhs) = delete;
+    MyMPMCQueue& operator=(const MyMPMCQueue& rhs) = delete;
+
+    // inserts x if there is room; returns false if the queue is full (copy)
+    bool tryEnqueue(const DataType& x)
+    {
+        size_t pos;
+        if(claim(enqueuePos, 0, 1, pos) == 0)
+            return false;
+        Cell& cell = ring[pos & mask];
+        cell.data = x;
+        cell.sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // inserts x if there is room; returns false if the queue is full (move)
+    bool tryEnqueue(DataType && x)
+    {
+        size_t pos;
+        if(claim(enqueuePos, 0, 1, pos) == 0)
+            return false;
+        Cell& cell = ring[pos & mask];
+        cell.data = std::move(x);
+        cell.sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // inserts x, waiting for room if the queue is full (copy)
+    void enqueue(const DataType& x)
+    {
+        unsigned spins = 0;
+        while(!tryEnqueue(x))
+            backoff(spins);
+    }
+
+    // inserts x, waiting for room if the queue is full (move)
+    void enqueue(DataType && x)
+    {
+        unsigned spins = 0;
+        while(!tryEnqueue(std::move(x)))
+            backoff(spins);
+    }
+
+    // moves the first element into x if there is one; returns false if the queue is empty
+    bool tryDequeue(DataType& x)
+    {
+        size_t pos;
+        if(claim(dequeuePos, 1, 1, pos) == 0)
+            return false;
+        Cell& cell = ring[pos & mask];
+        x = std::move(cell.data);
+        cell.sequence.store(pos + mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    // moves the first element into x, waiting for one if the queue is empty
+    void dequeue(DataType& x)
+    {
+        unsigned spins = 0;
+        while(!tryDequeue(x))
+            backoff(spins);
+    }
+
+    // inserts up to n elements starting at items with a single claim; returns the number inserted
+    // the inserted elements are contiguous in queue order
+    size_t tryEnqueueMany(const DataType* items, size_t n)
+    {
+        size_t pos;
+        n = claim(enqueuePos, 0, n, pos);
+        for(size_t i=0; i<n; ++i){
+            Cell& cell = ring[(pos + i) & mask];
+            cell.data = items[i];
+            cell.sequence.store(pos + i + 1, std::memory_order_release);
+        }
+        return n;
+    }
+
+    // inserts all n elements starting at items, waiting for room as needed
+    void enqueueMany(const DataType* items, size_t n)
+    {
+        unsigned spins = 0;
+        while(n > 0){
+            size_t k = tryEnqueueMany(items, n);
+            if(k == 0){
+                backoff(spins);
+                continue;
+            }
+            items += k;
+            n -= k;
+        }
+    }
+
+    // moves up to n elements to out with a single claim; returns the number removed
+    size_t tryDequeueMany(DataType* out, size_t n)
+    {
+        size_t pos;
+        n = claim(dequeuePos, 1, n, pos);
+        for(size_t i=0; i<n; ++i){
+            Cell& cell = ring[(pos + i) & mask];
+            out[i] = std::move(cell.data);
+            cell.sequence.store(pos + i + mask + 1, std::memory_order_release);
+        }
+        return n;
+    }
+
+    // moves between 1 and n elements to out, waiting if the queue is empty; returns the number removed
+    size_t dequeueMany(DataType* out, size_t n)
+    {
+        unsigned spins = 0;
+        size_t k;
+        while((k = tryDequeueMany(out, n)) == 0 && n > 0)
+            backoff(spins);
+        return k;
+    }
+
+    // returns the approximate number of queued elements
+    size_t size() const
+    {
+        size_t d = dequeuePos.load(std::memory_order_relaxed);
+        size_t e = enqueuePos.load(std::memory_order_relaxed);
+        return (e > d) ? e - d : 0;
+    }
+
+    // checks whether the queue is (approximately) empty
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    // returns the maximum number of elements the queue can hold
+    size_t capacity() const
+    {
+        return mask + 1;
+    }
+
+};
+
+#endif // __MYMPMCQUEUE_H__
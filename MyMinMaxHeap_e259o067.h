@@ -0,0 +1,213 @@
+#ifndef __MYMINMAXHEAP_H__
+#define __MYMINMAXHEAP_H__
+
+#include <iostream>
+#include <cstdlib>
+#include <utility>
+
+#include "MyVector_e259o067.h"
+
+// ComparableType should be comparable (<, >, ==, >=, <= operators implemented)
+
+// double-ended priority queue (min-max heap) in a 0-based array, laid out like MyBinaryHeap
+// nodes on even levels (the root is level 0) are no larger than any of their descendants,
+// nodes on odd levels are no smaller; the minimum is the root and the maximum is one of its children
+// findMin/findMax are O(1); enqueue, dequeueMin and dequeueMax are O(log n)
+
+template <typename ComparableType>
+class MyMinMaxHeap
+{
+  private:
+    MyVector<ComparableType> data;  // the array that holds the data elements
+
+    // returns the position of the parent of the node at position i
+    static size_t parentOf(const size_t i)
+    {
+        return (i - 1) / 2;
+    }
+
+    // checks whether position i is on a min level
+    static bool isMinLevel(size_t i)
+    {
+        bool minLevel = true;
+        for(++i; i > 1; i >>= 1)
+            minLevel = !minLevel;
+        return minLevel;
+    }
+
+    // checks whether a should sit above b on a min level (max level when isMin is false)
+    static bool before(const ComparableType& a, const ComparableType& b, const bool isMin)
+    {
+        return isMin ? (a < b) : (a > b);
+    }
+
+    // moves the element at position i up through the grandparents on its own kind of level
+    void bubbleUpGrand(size_t i, const bool isMin)
+    {
+        while(i >= 3){
+            size_t g = parentOf(parentOf(i));
+            if(!before(data[i], data[g], isMin))
+                break;
+            std::swap(data[i], data[g]);
+            i = g;
+        }
+    }
+
+    // moves the element at position i up
+    void percolateUp(size_t i)
+    {
+        if(i == 0)
+            return;
+        size_t p = parentOf(i);
+        bool minLevel = isMinLevel(i);
+        if(before(data[p], data[i], minLevel)){
+            // the new element belongs on the other kind of level
+            std::swap(data[i], data[p]);
+            bubbleUpGrand(p, !minLevel);
+        }
+        else
+            bubbleUpGrand(i, minLevel);
+    }
+
+    // moves the element at position i down
+    void percolateDown(size_t i)
+    {
+        const bool isMin = isMinLevel(i);
+        const size_t n = data.size();
+        while(2*i + 1 < n){
+            // the best among the children and grandchildren
+            size_t m = 2*i + 1;
+            size_t candidates[5] = {2*i + 2, 4*i + 3, 4*i + 4, 4*i + 5, 4*i + 6};
+            for(size_t k = 0; k < 5 && candidates[k] < n; ++k)
+                if(before(data[candidates[k]], data[m], isMin))
+                    m = candidates[k];
+            if(!before(data[m], data[i], isMin))
+                break;
+            std::swap(data[m], data[i]);
+            if(m <= 2*i + 2)
+                break;      // m is a child; it has no descendants on i's kind of level to violate
+            // m is a grandchild; its parent sits on the other kind of level
+            if(before(data[parentOf(m)], data[m], isMin))
+                std::swap(data[m], data[parentOf(m)]);
+            i = m;
+        }
+    }
+
+    // returns the position of the maximum element
+    size_t maxPos() const
+    {
+        if(data.size() == 1)
+            return 0;
+        if(data.size() == 2 || data[1] > data[2])
+            return 1;
+        return 2;
+    }
+
+    // removes the element at position i
+    void removeAt(const size_t i)
+    {
+        size_t last = data.size() - 1;
+        if(i != last)
+            data[i] = std::move(data[last]);
+        data.pop_back();
+        if(i < data.size())
+            percolateDown(i);
+    }
+
+  public:
+
+    // default constructor
+    MyMinMaxHeap()
+    {
+        ;
+    }
+
+    // inserts x into the heap (copy)
+    void enqueue(const ComparableType& x)
+    {
+        data.push_back(x);
+        percolateUp(data.size() - 1);
+    }
+
+    // inserts x into the heap (move)
+    void enqueue(ComparableType && x)
+    {
+        data.push_back(std::move(x));
+        percolateUp(data.size() - 1);
+    }
+
+    // accesses the smallest data element
+    const ComparableType& findMin() const
+    {
+        return data[0];
+    }
+
+    // accesses the largest data element
+    const ComparableType& findMax() const
+    {
+        return data[maxPos()];
+    }
+
+    // deletes the smallest data element
+    void dequeueMin()
+    {
+        if(empty()) return;
+        removeAt(0);
+    }
+
+    // deletes the largest data element
+    void dequeueMax()
+    {
+        if(empty()) return;
+        removeAt(maxPos());
+    }
+
+    // verifies the min-max ordering of every node against its parent and grandparent
+    bool verifyHeapProperty(void) const
+    {
+        for(size_t i = 1; i < data.size(); ++i){
+            size_t p = parentOf(i);
+            if(isMinLevel(p) ? (data[i] < data[p]) : (data[i] > data[p]))
+                return false;
+            if(i >= 3){
+                size_t g = parentOf(p);
+                if(isMinLevel(g) ? (data[i] < data[g]) : (data[i] > data[g]))
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    // checks whether the heap is empty
+    bool empty() const
+    {
+        return data.size() == 0;
+    }
+
+    // returns the size of the heap
+    size_t size() const
+    {
+        return data.size();
+    }
+
+    // removes all data elements from the heap
+    void clear()
+    {
+        while(!data.empty())
+            data.pop_back();
+    }
+
+    // prints the data in the array
+    void print() const
+    {
+        const char delim = '\t';
+        for (size_t i = 0; i < data.size(); ++ i) {
+            std::cout << data[i] << delim;
+        }
+        std::cout << std::endl;
+        return;
+    }
+
+};
+
+#endif // __MYMINMAXHEAP_H__
@@ -0,0 +1,171 @@
+#ifndef __MYMULTIQUEUE_H__
+#define __MYMULTIQUEUE_H__
+
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <random>
+#include <thread>
+
+#include "MyBinaryHeap_e259o067.h"
+
+// ComparableType should be comparable (<, >, ==, >=, <= operators implemented)
+
+// relaxed concurrent priority queue (MultiQueue): c * p MyBinaryHeaps, each behind its own lock
+// enqueue inserts into a random sub-heap; dequeue samples two random sub-heaps and takes the
+// better of their fronts
+// the order is only approximately by priority: the expected rank of a dequeued element among all
+// queued elements grows linearly with the number of sub-heaps, so the relaxation factor c trades
+// ordering quality (small c) for less lock contention (large c)
+
+template <typename ComparableType, size_t Arity = 2>
+class MyMultiQueue
+{
+  private:
+    static const size_t CACHE_LINE = 64;
+
+    struct alignas(CACHE_LINE) SubQueue
+    {
+        std::mutex lock;
+        MyBinaryHeap<ComparableType, Arity> heap;
+    };
+
+    SubQueue* queues;               // the sub-heaps
+    size_t numQueues;               // the number of sub-heaps
+    size_t relaxFactor;             // the number of sub-heaps per thread
+    std::atomic<size_t> theSize;    // the number of data elements in all sub-heaps
+
+    // returns a random sub-heap index
+    size_t randomQueue() const
+    {
+        static thread_local std::minstd_rand gen{std::random_device{}()};
+        return gen() % numQueues;
+    }
+
+    // checks every sub-heap; returns true if all of them are empty
+    bool allEmpty()
+    {
+        for(size_t i=0; i<numQueues; ++i){
+            std::lock_guard<std::mutex> guard(queues[i].lock);
+            if(!queues[i].heap.empty())
+                return false;
+        }
+        return true;
+    }
+
+  public:
+
+    // constructor; creates c sub-heaps per thread (at least two in total)
+    explicit MyMultiQueue(size_t numThreads = std::thread::hardware_concurrency(), size_t c = 2) :
+        theSize{0}
+    {
+        if(numThreads == 0) numThreads = 1;
+        if(c == 0) c = 1;
+        relaxFactor = c;
+        numQueues = c * numThreads;
+        if(numQueues < 2) numQueues = 2;
+        queues = new SubQueue[numQueues];
+    }
+
+    // the queue is shared by address between threads; copying or moving it is not supported
+    MyMultiQueue(const MyMultiQueue& rhs) = delete;
+    MyMultiQueue& operator=(const MyMultiQueue& rhs) = delete;
+
+    // destructor
+    ~MyMultiQueue()
+    {
+        delete [] queues;
+    }
+
+    // inserts x into a random sub-heap (copy)
+    void enqueue(const ComparableType& x)
+    {
+        while(true){
+            SubQueue& q = queues[randomQueue()];
+            if(q.lock.try_lock()){
+                q.heap.enqueue(x);
+                theSize.fetch_add(1, std::memory_order_relaxed);
+                q.lock.unlock();
+                return;
+            }
+        }
+    }
+
+    // inserts x into a random sub-heap (move)
+    void enqueue(ComparableType && x)
+    {
+        while(true){
+            SubQueue& q = queues[randomQueue()];
+            if(q.lock.try_lock()){
+                q.heap.enqueue(std::move(x));
+                theSize.fetch_add(1, std::memory_order_relaxed);
+                q.lock.unlock();
+                return;
+            }
+        }
+    }
+
+    // removes a high-priority data element into x: the better front of two random sub-heaps
+    // returns false only if every sub-heap was seen empty
+    bool dequeue(ComparableType& x)
+    {
+        size_t emptyRounds = 0;
+        while(true){
+            size_t i = randomQueue();
+            size_t j = randomQueue();
+            if(i == j) j = (j + 1) % numQueues;
+            SubQueue& a = queues[i];
+            SubQueue& b = queues[j];
+            if(std::try_lock(a.lock, b.lock) != -1)
+                continue;
+            {
+                std::lock_guard<std::mutex> guardA(a.lock, std::adopt_lock);
+                std::lock_guard<std::mutex> guardB(b.lock, std::adopt_lock);
+                MyBinaryHeap<ComparableType, Arity>* best = nullptr;
+                if(!a.heap.empty())
+                    best = &a.heap;
+                if(!b.heap.empty() && (best == nullptr || b.heap.front() > best->front()))
+                    best = &b.heap;
+                if(best != nullptr){
+                    x = best->front();
+                    best->dequeue();
+                    theSize.fetch_sub(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+            // both samples were empty; after a few misses check whether everything is
+            if(++emptyRounds >= 4){
+                if(theSize.load(std::memory_order_relaxed) == 0 && allEmpty())
+                    return false;
+                emptyRounds = 0;
+            }
+        }
+    }
+
+    // returns the approximate number of data elements
+    size_t size() const
+    {
+        return theSize.load(std::memory_order_relaxed);
+    }
+
+    // checks whether the queue is (approximately) empty
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    // returns the number of sub-heaps
+    size_t numSubQueues() const
+    {
+        return numQueues;
+    }
+
+    // returns the relaxation factor c (sub-heaps per thread)
+    size_t relaxation() const
+    {
+        return relaxFactor;
+    }
+
+};
+
+#endif // __MYMULTIQUEUE_H__
@@ -0,0 +1,95 @@
+#ifndef __MYPARALLELBST_H__
+#define __MYPARALLELBST_H__
+
+#include <utility>
+
+#include "MyBST_e259o067.h"
+#include "MyForkJoinPool_e259o067.h"
+
+// parallel set operations on MyBSTs on a MyForkJoinPool
+// the algorithms are the join-based ones of MyBST::unionWith/intersectWith/differenceWith; here
+// the two halves of every split are processed as a fork/join pair whenever they hold at least
+// grain nodes, so the recursion spreads over the pool down to grain-sized subtrees
+
+// gives the parallel operations access to the recursion inside MyBST
+template <typename ComparableType>
+class MyParallelBST
+{
+  public:
+    // runs the two halves of a step in parallel when they involve at least grain nodes
+    struct PoolFork
+    {
+        MyForkJoinPool& pool;
+        size_t grain;
+
+        template <typename F1, typename F2>
+        void operator()(const size_t work, F1&& f1, F2&& f2) const
+        {
+            if(work < grain){
+                f1();
+                f2();
+                return;
+            }
+            MyTaskGroup group(pool);
+            group.spawn(f1);
+            f2();
+            group.sync();
+        }
+    };
+
+    static void unionWith(MyBST<ComparableType>& lhs, MyBST<ComparableType> && rhs, MyForkJoinPool& pool, const size_t grain)
+    {
+        lhs.unionWith(std::move(rhs), PoolFork{pool, grain});
+    }
+
+    static void intersectWith(MyBST<ComparableType>& lhs, MyBST<ComparableType> && rhs, MyForkJoinPool& pool, const size_t grain)
+    {
+        lhs.intersectWith(std::move(rhs), PoolFork{pool, grain});
+    }
+
+    static void differenceWith(MyBST<ComparableType>& lhs, MyBST<ComparableType> && rhs, MyForkJoinPool& pool, const size_t grain)
+    {
+        lhs.differenceWith(std::move(rhs), PoolFork{pool, grain});
+    }
+};
+
+// adds the elements of rhs to lhs; rhs is left empty
+template <typename ComparableType>
+void parallelUnionWith(MyBST<ComparableType>& lhs, MyBST<ComparableType> && rhs, MyForkJoinPool& pool, size_t grain = 4096)
+{
+    MyParallelBST<ComparableType>::unionWith(lhs, std::move(rhs), pool, grain);
+}
+
+template <typename ComparableType>
+void parallelUnionWith(MyBST<ComparableType>& lhs, const MyBST<ComparableType>& rhs, MyForkJoinPool& pool, size_t grain = 4096)
+{
+    MyParallelBST<ComparableType>::unionWith(lhs, MyBST<ComparableType>(rhs), pool, grain);
+}
+
+// keeps only the elements of lhs that are also in rhs; rhs is left empty
+template <typename ComparableType>
+void parallelIntersectWith(MyBST<ComparableType>& lhs, MyBST<ComparableType> && rhs, MyForkJoinPool& pool, size_t grain = 4096)
+{
+    MyParallelBST<ComparableType>::intersectWith(lhs, std::move(rhs), pool, grain);
+}
+
+template <typename ComparableType>
+void parallelIntersectWith(MyBST<ComparableType>& lhs, const MyBST<ComparableType>& rhs, MyForkJoinPool& pool, size_t grain = 4096)
+{
+    MyParallelBST<ComparableType>::intersectWith(lhs, MyBST<ComparableType>(rhs), pool, grain);
+}
+
+// removes the elements of rhs from lhs; rhs is left empty
+template <typename ComparableType>
+void parallelDifferenceWith(MyBST<ComparableType>& lhs, MyBST<ComparableType> && rhs, MyForkJoinPool& pool, size_t grain = 4096)
+{
+    MyParallelBST<ComparableType>::differenceWith(lhs, std::move(rhs), pool, grain);
+}
+
+template <typename ComparableType>
+void parallelDifferenceWith(MyBST<ComparableType>& lhs, const MyBST<ComparableType>& rhs, MyForkJoinPool& pool, size_t grain = 4096)
+{
+    MyParallelBST<ComparableType>::differenceWith(lhs, MyBST<ComparableType>(rhs), pool, grain);
+}
+
+#endif // __MYPARALLELBST_H__
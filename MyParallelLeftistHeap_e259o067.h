@@ -0,0 +1,65 @@
+#ifndef __MYPARALLELLEFTISTHEAP_H__
+#define __MYPARALLELLEFTISTHEAP_H__
+
+#include <utility>
+
+#include "MyForkJoinPool_e259o067.h"
+#include "MyLeftistHeap_e259o067.h"
+#include "MyVector_e259o067.h"
+
+// parallel melds of MyLeftistHeaps on a MyForkJoinPool
+// the heaps are melded along a balanced reduction tree: the two halves of the range are reduced
+// in parallel and their results melded, so N heaps need O(log N) rounds of melds instead of a
+// chain of N - 1; melds of disjoint heaps share nothing (every heap has its own node arena), so
+// the tasks need no locking
+
+// melds heaps[lo, hi) into heaps[lo]; the others are left empty
+template <typename ComparableType>
+void parallelMeldRange(MyVector<MyLeftistHeap<ComparableType> >& heaps, const size_t lo, const size_t hi, MyForkJoinPool& pool)
+{
+    if(hi - lo < 2) return;
+    const size_t mid = lo + (hi - lo) / 2;
+    MyTaskGroup group(pool);
+    group.spawn([&heaps, lo, mid, &pool]{ parallelMeldRange(heaps, lo, mid, pool); });
+    parallelMeldRange(heaps, mid, hi, pool);
+    group.sync();
+    heaps[lo].merge(std::move(heaps[mid]));
+}
+
+// melds all heaps into one and returns it; the input heaps are left empty
+template <typename ComparableType>
+MyLeftistHeap<ComparableType> parallelMeld(MyVector<MyLeftistHeap<ComparableType> >& heaps, MyForkJoinPool& pool)
+{
+    MyLeftistHeap<ComparableType> result;
+    if(heaps.empty()) return result;
+    parallelMeldRange(heaps, 0, heaps.size(), pool);
+    result.merge(std::move(heaps[0]));
+    return result;
+}
+
+// builds a leftist heap from items in parallel: every chunk of at least grain elements is built
+// bottom-up by its own task, and the chunk heaps are then melded by parallelMeld
+template <typename ComparableType>
+MyLeftistHeap<ComparableType> parallelBuildLeftistHeap(const MyVector<ComparableType>& items, MyForkJoinPool& pool, size_t grain = 4096)
+{
+    if(grain == 0) grain = 1;
+    size_t chunks = (items.size() + grain - 1) / grain;
+    if(chunks <= 1)
+        return MyLeftistHeap<ComparableType>(items);
+    MyVector<MyLeftistHeap<ComparableType> > heaps(chunks);
+    MyTaskGroup group(pool);
+    for(size_t c = 0; c < chunks; ++c){
+        group.spawn([&items, &heaps, c, chunks]{
+            const size_t lo = items.size() * c / chunks;
+            const size_t hi = items.size() * (c + 1) / chunks;
+            MyVector<ComparableType> part(hi - lo);
+            for(size_t i = lo; i < hi; ++i)
+                part[i - lo] = items[i];
+            heaps[c] = MyLeftistHeap<ComparableType>(part);
+        });
+    }
+    group.sync();
+    return parallelMeld(heaps, pool);
+}
+
+#endif // __MYPARALLELLEFTISTHEAP_H__
@@ -0,0 +1,241 @@
+#ifndef __MYPERSISTENTLEFTISTHEAP_H__
+#define __MYPERSISTENTLEFTISTHEAP_H__
+
+#include <atomic>
+#include <utility>
+
+#include "MyVector_e259o067.h"
+
+// ComparableType should be comparable (<, >, ==, >=, <= operators implemented)
+
+// persistent (immutable) leftist max-heap: enqueue, dequeue and merge leave the heap unchanged
+// and return a new version that shares every untouched subtree with the old one
+// a merge copies only the nodes on the two right spines it walks, O(log n) of them, so every
+// operation costs O(log n) time and space, and a snapshot is a copy of the heap object: O(1)
+// nodes are immutable and reference-counted (atomically, so versions may be handed to other
+// threads); a node is freed when the last version that reaches it goes away
+
+template <typename ComparableType>
+class MyPersistentLeftistHeap
+{
+  private:
+    static const size_t MAX_PATH = 2 * 64;  // two right spines; a spine of n nodes is at most log2(n + 1) long
+
+    struct HeapNode
+    {
+        ComparableType data;
+        const HeapNode* left;
+        const HeapNode* right;
+        int npl;
+        mutable std::atomic<size_t> refs;   // the number of parents and heap versions holding the node
+
+        HeapNode(const ComparableType& d, const HeapNode* lt, const HeapNode* rt, int np) :
+            data{d},
+            left{lt},
+            right{rt},
+            npl{np},
+            refs{1}
+        {
+            ;
+        }
+
+        HeapNode(ComparableType && d, const HeapNode* lt, const HeapNode* rt, int np) :
+            data{std::move(d)},
+            left{lt},
+            right{rt},
+            npl{np},
+            refs{1}
+        {
+            ;
+        }
+    };
+
+    const HeapNode* root;   // root of the heap tree
+    size_t theSize;         // the number of data elements
+
+    // takes over a tree that is already referenced on behalf of the new heap
+    MyPersistentLeftistHeap(const HeapNode* r, const size_t n) :
+        root{r},
+        theSize{n}
+    {
+        ;
+    }
+
+    // returns the null path length of node t; an empty subtree has -1
+    static int nplOf(const HeapNode* t)
+    {
+        return (t == nullptr) ? -1 : t->npl;
+    }
+
+    // adds a reference to node t
+    static const HeapNode* acquire(const HeapNode* t)
+    {
+        if(t != nullptr)
+            t->refs.fetch_add(1, std::memory_order_relaxed);
+        return t;
+    }
+
+    // drops a reference to node t and frees every node no longer reachable
+    // iterative, so a long chain of nodes cannot overflow the call stack
+    static void release(const HeapNode* t)
+    {
+        if(!dropRef(t)) return;
+        MyVector<const HeapNode*> dead;
+        dead.push_back(t);
+        while(!dead.empty()){
+            t = dead.back();
+            dead.pop_back();
+            if(dropRef(t->left)) dead.push_back(t->left);
+            if(dropRef(t->right)) dead.push_back(t->right);
+            delete t;
+        }
+    }
+
+    // drops a reference to node t; returns true if it was the last one
+    static bool dropRef(const HeapNode* t)
+    {
+        return t != nullptr && t->refs.fetch_sub(1, std::memory_order_acq_rel) == 1;
+    }
+
+    // creates a node with children lt and rt (whose references it takes over), fixing the
+    // leftist topology
+    template <typename T>
+    static const HeapNode* makeNode(T && x, const HeapNode* lt, const HeapNode* rt)
+    {
+        if(nplOf(lt) < nplOf(rt)) std::swap(lt, rt);
+        return new HeapNode(std::forward<T>(x), lt, rt, nplOf(rt) + 1);
+    }
+
+    // merges the trees rooted at r1 and r2 into a new tree; both inputs are left unchanged
+    // the nodes on the merge path are copied bottom-up; everything else is shared
+    static const HeapNode* merge(const HeapNode* r1, const HeapNode* r2)
+    {
+        const HeapNode* path[MAX_PATH];
+        size_t n = 0;
+        while(r1 != nullptr && r2 != nullptr){
+            if(!(r1->data > r2->data)) std::swap(r1, r2);
+            path[n++] = r1;
+            r1 = r1->right;
+        }
+        const HeapNode* t = acquire((r1 != nullptr) ? r1 : r2);
+        while(n > 0){
+            const HeapNode* p = path[--n];
+            t = makeNode(p->data, acquire(p->left), t);
+        }
+        return t;
+    }
+
+    // merges a new node holding x into the tree rooted at r, which is left unchanged
+    // walks the right spine of r only, and x goes straight into its final node (moved if an rvalue)
+    template <typename T>
+    static const HeapNode* insert(const HeapNode* r, T && x)
+    {
+        const HeapNode* path[MAX_PATH];
+        size_t n = 0;
+        while(r != nullptr && !(x > r->data)){
+            path[n++] = r;
+            r = r->right;
+        }
+        const HeapNode* t = makeNode(std::forward<T>(x), nullptr, acquire(r));
+        while(n > 0){
+            const HeapNode* p = path[--n];
+            t = makeNode(p->data, acquire(p->left), t);
+        }
+        return t;
+    }
+
+  public:
+
+    // default constructor
+    MyPersistentLeftistHeap() :
+        root{nullptr},
+        theSize{0}
+    {
+        ;
+    }
+
+    // copy constructor; O(1), the two versions share all nodes
+    MyPersistentLeftistHeap(const MyPersistentLeftistHeap& rhs) :
+        root{acquire(rhs.root)},
+        theSize{rhs.theSize}
+    {
+        ;
+    }
+
+    // move constructor
+    MyPersistentLeftistHeap(MyPersistentLeftistHeap && rhs) :
+        root{rhs.root},
+        theSize{rhs.theSize}
+    {
+        rhs.root = nullptr;
+        rhs.theSize = 0;
+    }
+
+    // destructor
+    ~MyPersistentLeftistHeap()
+    {
+        release(root);
+    }
+
+    // copy assignment
+    MyPersistentLeftistHeap& operator=(const MyPersistentLeftistHeap& rhs)
+    {
+        MyPersistentLeftistHeap copy = rhs;
+        std::swap(root, copy.root);
+        std::swap(theSize, copy.theSize);
+        return *this;
+    }
+
+    // move assignment
+    MyPersistentLeftistHeap& operator=(MyPersistentLeftistHeap && rhs)
+    {
+        std::swap(root, rhs.root);
+        std::swap(theSize, rhs.theSize);
+        return *this;
+    }
+
+    // returns the data element with the highest priority
+    const ComparableType& front() const
+    {
+        return root->data;
+    }
+
+    // returns a new version with x inserted
+    MyPersistentLeftistHeap enqueue(const ComparableType& x) const
+    {
+        return MyPersistentLeftistHeap(insert(root, x), theSize + 1);
+    }
+
+    MyPersistentLeftistHeap enqueue(ComparableType && x) const
+    {
+        return MyPersistentLeftistHeap(insert(root, std::move(x)), theSize + 1);
+    }
+
+    // returns a new version without the data element with the highest priority
+    MyPersistentLeftistHeap dequeue() const
+    {
+        if(empty()) return *this;
+        return MyPersistentLeftistHeap(merge(root->left, root->right), theSize - 1);
+    }
+
+    // returns a new version holding the data elements of both heaps
+    MyPersistentLeftistHeap merge(const MyPersistentLeftistHeap& rhs) const
+    {
+        return MyPersistentLeftistHeap(merge(root, rhs.root), theSize + rhs.theSize);
+    }
+
+    // checks of the heap is empty
+    bool empty() const
+    {
+        return theSize == 0;
+    }
+
+    // checks the size of the heap
+    size_t size() const
+    {
+        return theSize;
+    }
+
+};
+
+#endif // __MYPERSISTENTLEFTISTHEAP_H__
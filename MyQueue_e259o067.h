@@ -4,68 +4,91 @@
 #include <iostream>
 #include <algorithm>
 
-#include "MyVector.h"
+#include "MyVector_e259o067.h"
 
+// ring buffer queue; the capacity is always a power of two so positions wrap with a mask
 template <typename DataType>
-class MyQueue : private MyVector<DataType>
-{  
+class MyQueue
+{
+  public:
+
+    // a read-only view of contiguous queued elements
+    struct Span
+    {
+        const DataType* data;
+        size_t size;
+    };
+
   private:
-    size_t dataStart, dataEnd;
+    MyVector<DataType> ring;    // the slots of the ring buffer; ring.size() is the capacity
+    size_t dataStart;           // the slot holding the first element
+    size_t theSize;             // the number of elements in the queue
+    size_t mask;                // capacity - 1
+
+    static const size_t MIN_CAPACITY = 16;
 
-    // changes the size of the array to newSize
-    void resize(size_t newSize)
+    // returns the smallest power of two that is at least n
+    static size_t roundUpPow2(size_t n)
     {
-        if(newSize > capacity())
-            reserve(newSize*2);
-        MyVector<DataType>::resize(newSize);
+        size_t c = MIN_CAPACITY;
+        while(c < n)
+            c <<= 1;
+        return c;
     }
 
-    // requests for newCapacity amount of space
-    void reserve(size_t newCapacity)
+    // maps the ith element of the queue to its slot
+    size_t slot(size_t i) const
     {
-        if(newCapacity < size())
-            return;
-        DataType *newArray = new DataType[newCapacity];
-        for(size_t i=0; i<size(); ++i)
-            newArray[i] = std::move((*this)[(dataStart+i)%size()]);
+        return (dataStart + i) & mask;
+    }
+
+    // grows the ring so that it holds at least newCapacity elements
+    // each element is moved once and the queue is unwrapped to start at slot 0
+    void grow(size_t newCapacity)
+    {
+        MyVector<DataType> newRing(roundUpPow2(newCapacity));
+        for(size_t i=0; i<theSize; ++i)
+            newRing[i] = std::move(ring[slot(i)]);
+        ring = std::move(newRing);
         dataStart = 0;
-        dataEnd = size();
-        for(size_t i=0; i<size(); ++i)
-            (*this)[i] = newArray[i];
-        delete [] newArray;
-        MyVector<DataType>::reserve(newCapacity);
+        mask = ring.size() - 1;
     }
 
   public:
 
-    // default constructor
-    explicit MyQueue(size_t initSize = 0) : MyVector<DataType>()
+    // default constructor; initSize is a capacity hint
+    explicit MyQueue(size_t initSize = 0) :
+        ring(roundUpPow2(initSize)),
+        dataStart{0},
+        theSize{0}
     {
-        dataStart = dataEnd = 0;
+        mask = ring.size() - 1;
     }
 
     // copy constructor
-    MyQueue(const MyQueue & rhs) : 
-        MyVector<DataType>(rhs),
+    MyQueue(const MyQueue & rhs) :
+        ring(rhs.ring),
         dataStart{rhs.dataStart},
-        dataEnd{rhs.dataEnd}
+        theSize{rhs.theSize},
+        mask{rhs.mask}
     {
-        
+
     }
 
     // move constructor
-    MyQueue(MyQueue && rhs) : 
-        MyVector<DataType>(std::move(rhs)),
+    MyQueue(MyQueue && rhs) :
+        ring(std::move(rhs.ring)),
         dataStart{rhs.dataStart},
-        dataEnd{rhs.dataEnd}
+        theSize{rhs.theSize},
+        mask{rhs.mask}
     {
-        
+        rhs.dataStart = rhs.theSize = rhs.mask = 0;
     }
 
     // destructor
     ~MyQueue()
     {
-        
+
     }
 
     // copy assignment
@@ -79,26 +102,49 @@ class MyQueue : private MyVector<DataType>
     // move assignment
     MyQueue & operator= (MyQueue && rhs)
     {
+        std::swap(ring, rhs.ring);
         std::swap(dataStart, rhs.dataStart);
-        std::swap(dataEnd, rhs.dataEnd);
-        std::swap(*this, rhs);
+        std::swap(theSize, rhs.theSize);
+        std::swap(mask, rhs.mask);
         return(*this);
     }
 
     // insert x into the queue
     void enqueue(const DataType & x)
     {
-        resize(size()+1);
-        (*this)[dataEnd] = (x);
-        dataEnd = ++dataEnd%capacity();
+        if(theSize == capacity())
+            grow(2*capacity());
+        ring[slot(theSize++)] = (x);
     }
 
     // insert x into the queue
     void enqueue(DataType && x)
     {
-        resize(size()+1);
-        (*this)[dataEnd] = std::move(x);
-        dataEnd = ++dataEnd%capacity();
+        if(theSize == capacity())
+            grow(2*capacity());
+        ring[slot(theSize++)] = std::move(x);
+    }
+
+    // inserts the n elements starting at items into the queue, in order
+    // grows at most once and copies in at most two contiguous runs
+    void enqueueMany(const DataType* items, size_t n)
+    {
+        if(n == 0)
+            return;
+        if(theSize + n > capacity())
+            grow(theSize + n);
+        size_t first = slot(theSize);
+        size_t run = std::min(n, capacity() - first);
+        std::copy(items, items + run, &ring[first]);
+        std::copy(items + run, items + n, &ring[0]);
+        theSize += n;
+    }
+
+    // inserts all elements of items into the queue, in order
+    void enqueueMany(const MyVector<DataType>& items)
+    {
+        if(!items.empty())
+            enqueueMany(&items[0], items.size());
     }
 
     // remove the first element from the queue
@@ -106,36 +152,94 @@ class MyQueue : private MyVector<DataType>
     {
         if(!empty())
         {
-            dataStart = ++dataStart%capacity();
-            resize(size()-1);
+            ring[dataStart] = DataType();
+            dataStart = (dataStart + 1) & mask;
+            --theSize;
         }
     }
 
+    // removes the first n elements from the queue (or all of them if fewer are queued)
+    // returns the number of elements removed
+    size_t dequeueMany(size_t n)
+    {
+        n = std::min(n, theSize);
+        for(size_t i=0; i<n; ++i)
+            ring[slot(i)] = DataType();
+        dataStart = slot(n);
+        theSize -= n;
+        return n;
+    }
+
+    // moves the first n elements (or all of them if fewer are queued) to the end of out
+    // returns the number of elements removed
+    size_t dequeueMany(MyVector<DataType>& out, size_t n)
+    {
+        n = std::min(n, theSize);
+        for(size_t i=0; i<n; ++i)
+            out.push_back(std::move(ring[slot(i)]));
+        return dequeueMany(n);
+    }
+
     // access the first element of the queue
+    DataType & front(void)
+    {
+        return ring[dataStart];
+    }
+
     const DataType & front(void) const
     {
-        return(*this)[dataStart];
+        return ring[dataStart];
+    }
+
+    // access the last element of the queue
+    const DataType & back(void) const
+    {
+        return ring[slot(theSize - 1)];
+    }
+
+    // remove the last element from the queue, so the queue can also serve as a deque
+    void dequeueBack(void)
+    {
+        if(!empty())
+            ring[slot(--theSize)] = DataType();
+    }
+
+    // returns the longest contiguous run of elements starting at the front, without copying
+    // the view is invalidated by any operation that inserts into the queue
+    Span frontSpan(void) const
+    {
+        if(empty())
+            return Span{nullptr, 0};
+        return Span{&ring[dataStart], std::min(theSize, capacity() - dataStart)};
+    }
+
+    // returns all queued elements as at most two contiguous runs, in queue order
+    // second is empty unless the queue wraps around the end of the ring
+    void frontSpans(Span& first, Span& second) const
+    {
+        first = frontSpan();
+        second = Span{first.size < theSize ? &ring[0] : nullptr, theSize - first.size};
     }
 
     // check if the queue is empty; return TRUE is empty; FALSE otherwise
     bool empty(void) const
     {
-        return MyVector<DataType>::empty();
+        return theSize == 0;
     }
 
     // access the size of the queue
     size_t size() const
     {
-        return MyVector<DataType>::size();
+        return theSize;
     }
 
     // access the capacity of the queue
-    size_t capacity(void) const 
+    size_t capacity(void) const
     {
-        return MyVector<DataType>::capacity();
+        return ring.size();
     }
 
 };
 
 
-#endif // __MYQUEUE_H__
\ No newline at end of file
+#endif // __MYQUEUE_H__
@@ -0,0 +1,184 @@
+#ifndef __MYRADIXHEAP_H__
+#define __MYRADIXHEAP_H__
+
+#include <bit>
+#include <climits>
+#include <stdexcept>
+#include <type_traits>
+
+#include "MyVector_e259o067.h"
+
+// monotone min-priority queue for unsigned integer keys (radix heap)
+// the extracted keys must be non-decreasing: a key may never be smaller than the last key
+// extracted, which holds for Dijkstra-style shortest paths and discrete-event simulation
+// elements are kept in buckets by the highest bit in which their key differs from the last
+// extracted key; enqueue is O(1) and each element is redistributed at most once per bit,
+// so dequeue is O(log C) amortized with no key comparisons on the insert path
+// ValueType is an optional payload stored next to the key
+// front() only looks: it finds the minimum without splitting a bucket, so peeking never raises
+// the lower bound for later inserts; the position found is cached until the next dequeue
+
+template <typename KeyType, typename ValueType = KeyType>
+class MyRadixHeap
+{
+    static_assert(std::is_unsigned<KeyType>::value, "MyRadixHeap requires an unsigned integer key type");
+
+  private:
+    static const int KEY_BITS = sizeof(KeyType) * CHAR_BIT;
+
+    struct Entry
+    {
+        KeyType key;
+        ValueType value;
+    };
+
+    MyVector<Entry> buckets[KEY_BITS + 1];  // bucket i holds keys whose highest differing bit from last is bit i-1
+    KeyType last;                           // the last extracted key; no key is below it
+    size_t theSize;                         // the number of data elements in the heap
+    int minBucket;                          // the position of the minimum found by front(), or -1
+    size_t minIndex;
+
+    // returns the bucket of key k relative to last
+    int bucketOf(const KeyType k) const
+    {
+        return (int)std::bit_width((KeyType)(k ^ last));
+    }
+
+    // returns the position of the minimum without moving any element
+    // bucket 0 only holds keys equal to last; otherwise the first non-empty bucket holds keys
+    // below those of every later bucket, so only that one is scanned
+    const Entry& findMin()
+    {
+        if(minBucket < 0){
+            int i = 0;
+            while(buckets[i].empty())
+                ++i;
+            size_t m = buckets[i].size() - 1;
+            for(size_t j=0; j<buckets[i].size(); ++j)
+                if(buckets[i][j].key < buckets[i][m].key)
+                    m = j;
+            minBucket = i;
+            minIndex = m;
+        }
+        return buckets[minBucket][minIndex];
+    }
+
+    // makes sure bucket 0 holds the minimum keys by splitting the first non-empty bucket
+    void pull()
+    {
+        if(!buckets[0].empty())
+            return;
+        int i = 1;
+        while(buckets[i].empty())
+            ++i;
+        KeyType newLast = buckets[i][0].key;
+        for(size_t j=1; j<buckets[i].size(); ++j)
+            if(buckets[i][j].key < newLast)
+                newLast = buckets[i][j].key;
+        last = newLast;
+        for(size_t j=0; j<buckets[i].size(); ++j)
+            buckets[bucketOf(buckets[i][j].key)].push_back(std::move(buckets[i][j]));
+        buckets[i].resize(0);
+    }
+
+    // places e into its bucket
+    void insert(Entry && e)
+    {
+        if(e.key < last)
+            throw std::invalid_argument("MyRadixHeap: key is smaller than the last extracted key");
+        int b = bucketOf(e.key);
+        buckets[b].push_back(std::move(e));
+        ++theSize;
+        if(minBucket >= 0 && buckets[b].back().key < buckets[minBucket][minIndex].key){
+            minBucket = b;
+            minIndex = buckets[b].size() - 1;
+        }
+    }
+
+  public:
+
+    // default constructor
+    MyRadixHeap() :
+        last{0},
+        theSize{0},
+        minBucket{-1},
+        minIndex{0}
+    {
+        ;
+    }
+
+    // inserts key k; k must not be smaller than the last extracted key
+    void enqueue(const KeyType k)
+    {
+        insert(Entry{k, ValueType(k)});
+    }
+
+    // inserts key k with payload v; k must not be smaller than the last extracted key
+    void enqueue(const KeyType k, const ValueType& v)
+    {
+        insert(Entry{k, v});
+    }
+
+    void enqueue(const KeyType k, ValueType && v)
+    {
+        insert(Entry{k, std::move(v)});
+    }
+
+    // accesses the smallest key; the heap must not be empty
+    KeyType front()
+    {
+        return findMin().key;
+    }
+
+    // accesses the payload of the smallest key; the heap must not be empty
+    const ValueType& frontValue()
+    {
+        return findMin().value;
+    }
+
+    // deletes the element with the smallest key
+    void dequeue()
+    {
+        if(empty()) return;
+        // move the minimum front() reports to the back of its bucket, so that it is the element
+        // removed even among equal keys
+        findMin();
+        MyVector<Entry>& b = buckets[minBucket];
+        std::swap(b[minIndex], b[b.size() - 1]);
+        pull();
+        buckets[0].pop_back();
+        --theSize;
+        minBucket = -1;
+    }
+
+    // returns the smallest key that may still be inserted
+    KeyType lowerBound() const
+    {
+        return last;
+    }
+
+    // checks whether the heap is empty
+    bool empty() const
+    {
+        return theSize == 0;
+    }
+
+    // returns the size of the heap
+    size_t size() const
+    {
+        return theSize;
+    }
+
+    // removes all data elements; the lower bound is reset to 0
+    void clear()
+    {
+        for(int i=0; i<=KEY_BITS; ++i)
+            buckets[i].resize(0);
+        last = 0;
+        theSize = 0;
+        minBucket = -1;
+    }
+
+};
+
+#endif // __MYRADIXHEAP_H__
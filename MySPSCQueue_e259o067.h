@@ -0,0 +1,181 @@
+#ifndef __MYSPSCQUEUE_H__
+#define __MYSPSCQUEUE_H__
+
+#include <atomic>
+#include <algorithm>
+#include <cstddef>
+
+#include "MyVector_e259o067.h"
+
+// bounded wait-free single-producer/single-consumer queue
+// exactly one thread may call the producer operations (tryEnqueue, enqueueMany)
+// and exactly one thread may call the consumer operations (front, tryDequeue, dequeue, dequeueMany)
+// the consumer index and the producer index live on separate cache lines, and each side keeps a
+// private cached copy of the other side's index so the shared line is only read when the cache runs out
+
+template <typename DataType>
+class MySPSCQueue
+{
+  private:
+    static const size_t CACHE_LINE = 64;
+
+    // producer side
+    alignas(CACHE_LINE) std::atomic<size_t> tail;   // the next position to write
+    size_t headCache;                               // the producer's last observed value of head
+
+    // consumer side
+    alignas(CACHE_LINE) std::atomic<size_t> head;   // the next position to read
+    size_t tailCache;                               // the consumer's last observed value of tail
+
+    // shared, read-only after construction
+    alignas(CACHE_LINE) MyVector<DataType> ring;    // the slots; the capacity is a power of two
+    size_t mask;                                    // capacity - 1
+
+    // returns the smallest power of two that is at least n
+    static size_t roundUpPow2(size_t n)
+    {
+        size_t c = 2;
+        while(c < n)
+            c <<= 1;
+        return c;
+    }
+
+    // returns the number of free slots seen by the producer, refreshing the cache only when needed
+    size_t freeSlots(const size_t t, const size_t wanted)
+    {
+        size_t avail = capacity() - (t - headCache);
+        if(avail < wanted){
+            headCache = head.load(std::memory_order_acquire);
+            avail = capacity() - (t - headCache);
+        }
+        return avail;
+    }
+
+    // returns the number of filled slots seen by the consumer, refreshing the cache only when needed
+    size_t filledSlots(const size_t h, const size_t wanted)
+    {
+        size_t avail = tailCache - h;
+        if(avail < wanted){
+            tailCache = tail.load(std::memory_order_acquire);
+            avail = tailCache - h;
+        }
+        return avail;
+    }
+
+  public:
+
+    // constructor; the capacity is rounded up to a power of two
+    explicit MySPSCQueue(size_t cap = 1024) :
+        tail{0},
+        headCache{0},
+        head{0},
+        tailCache{0},
+        ring(roundUpPow2(cap))
+    {
+        mask = ring.size() - 1;
+    }
+
+    // the queue is shared by address between two threads; copying or moving it is not supported
+    MySPSCQueue(const MySPSCQueue& rhs) = delete;
+    MySPSCQueue& operator=(const MySPSCQueue& rhs) = delete;
+
+    // producer: inserts x if there is room; returns false if the queue is full (copy)
+    bool tryEnqueue(const DataType& x)
+    {
+        const size_t t = tail.load(std::memory_order_relaxed);
+        if(freeSlots(t, 1) == 0)
+            return false;
+        ring[t & mask] = x;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // producer: inserts x if there is room; returns false if the queue is full (move)
+    bool tryEnqueue(DataType && x)
+    {
+        const size_t t = tail.load(std::memory_order_relaxed);
+        if(freeSlots(t, 1) == 0)
+            return false;
+        ring[t & mask] = std::move(x);
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // producer: inserts as many of the n elements starting at items as fit, then publishes them
+    // with a single store; returns the number inserted
+    size_t enqueueMany(const DataType* items, size_t n)
+    {
+        const size_t t = tail.load(std::memory_order_relaxed);
+        n = std::min(n, freeSlots(t, n));
+        for(size_t i=0; i<n; ++i)
+            ring[(t + i) & mask] = items[i];
+        tail.store(t + n, std::memory_order_release);
+        return n;
+    }
+
+    // consumer: returns the first element, or nullptr if the queue is empty
+    // the pointer stays valid until the consumer dequeues it
+    const DataType* front()
+    {
+        const size_t h = head.load(std::memory_order_relaxed);
+        if(filledSlots(h, 1) == 0)
+            return nullptr;
+        return &ring[h & mask];
+    }
+
+    // consumer: removes the first element if there is one; returns false if the queue is empty
+    bool dequeue()
+    {
+        const size_t h = head.load(std::memory_order_relaxed);
+        if(filledSlots(h, 1) == 0)
+            return false;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // consumer: moves the first element into x if there is one; returns false if the queue is empty
+    bool tryDequeue(DataType& x)
+    {
+        const size_t h = head.load(std::memory_order_relaxed);
+        if(filledSlots(h, 1) == 0)
+            return false;
+        x = std::move(ring[h & mask]);
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // consumer: moves up to n elements to out, then releases their slots with a single store
+    // returns the number removed
+    size_t dequeueMany(DataType* out, size_t n)
+    {
+        const size_t h = head.load(std::memory_order_relaxed);
+        n = std::min(n, filledSlots(h, n));
+        for(size_t i=0; i<n; ++i)
+            out[i] = std::move(ring[(h + i) & mask]);
+        head.store(h + n, std::memory_order_release);
+        return n;
+    }
+
+    // checks whether the queue is empty; exact only when called from the producer or the consumer
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    // returns the number of queued elements; exact only when called from the producer or the consumer
+    size_t size() const
+    {
+        const size_t h = head.load(std::memory_order_acquire);
+        const size_t t = tail.load(std::memory_order_acquire);
+        return t - h;
+    }
+
+    // returns the maximum number of elements the queue can hold
+    size_t capacity() const
+    {
+        return mask + 1;
+    }
+
+};
+
+#endif // __MYSPSCQUEUE_H__
@@ -0,0 +1,200 @@
+#ifndef __MYSLIDINGWINDOW_H__
+#define __MYSLIDINGWINDOW_H__
+
+#include <algorithm>
+#include <functional>
+
+#include "MyQueue_e259o067.h"
+#include "MyStack_e259o067.h"
+
+// FIFO windows that maintain an aggregate of their contents in amortized O(1) per operation
+//   MyMonotonicQueue   min or max (any strict weak order); stores only the candidates that can still win
+//   MyTwoStackQueue    any associative operation (sum, min, max, gcd, matrix product, ...)
+
+// associative operations for MyTwoStackQueue
+template <typename DataType>
+struct MyMinOp
+{
+    DataType operator()(const DataType& a, const DataType& b) const
+    {
+        return std::min(a, b);
+    }
+};
+
+template <typename DataType>
+struct MyMaxOp
+{
+    DataType operator()(const DataType& a, const DataType& b) const
+    {
+        return std::max(a, b);
+    }
+};
+
+template <typename DataType>
+struct MySumOp
+{
+    DataType operator()(const DataType& a, const DataType& b) const
+    {
+        return a + b;
+    }
+};
+
+// sliding-window extreme: front() is the element that wins Compare among the queued ones
+// (the minimum for std::less, the maximum for std::greater)
+// an element is dropped from the candidates as soon as a newer element is at least as good,
+// so every element is enqueued and removed from the candidates at most once
+template <typename DataType, typename Compare = std::less<DataType> >
+class MyMonotonicQueue
+{
+  private:
+    struct Candidate
+    {
+        DataType value;
+        size_t seq;         // the position of the element in the stream
+    };
+
+    MyQueue<Candidate> candidates;  // strictly improving from back to front
+    size_t pushCount;               // the number of elements ever enqueued
+    size_t popCount;                // the number of elements ever dequeued
+    Compare comp;
+
+  public:
+
+    // default constructor
+    explicit MyMonotonicQueue(const Compare& c = Compare()) :
+        pushCount{0},
+        popCount{0},
+        comp{c}
+    {
+        ;
+    }
+
+    // inserts x at the back of the window
+    void enqueue(const DataType& x)
+    {
+        while(!candidates.empty() && !comp(candidates.back().value, x))
+            candidates.dequeueBack();
+        candidates.enqueue(Candidate{x, pushCount++});
+    }
+
+    // removes the oldest element of the window
+    void dequeue()
+    {
+        if(empty())
+            return;
+        if(candidates.front().seq == popCount)
+            candidates.dequeue();
+        ++popCount;
+    }
+
+    // returns the best element in the window; the window must not be empty
+    const DataType& front() const
+    {
+        return candidates.front().value;
+    }
+
+    // checks whether the window is empty
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    // returns the number of elements in the window
+    size_t size() const
+    {
+        return pushCount - popCount;
+    }
+
+};
+
+// FIFO queue that folds its contents with an associative operation Op
+// elements are pushed onto a back stack whose fold is kept as a single running value; when the
+// front stack runs empty the back stack is flipped onto it, and each front entry stores the fold
+// of itself and every newer entry beneath it
+template <typename DataType, typename Op = MySumOp<DataType> >
+class MyTwoStackQueue
+{
+  private:
+    struct Entry
+    {
+        DataType value;
+        DataType agg;       // Op over this element and all newer elements in the front stack
+    };
+
+    MyStack<Entry> frontStack;      // older elements; the oldest is on top
+    MyStack<DataType> backStack;    // newer elements; the newest is on top
+    DataType backAgg;               // Op over the back stack, oldest first
+    Op op;
+
+    // moves the back stack onto the front stack, computing the suffix folds
+    void flip()
+    {
+        while(!backStack.empty()){
+            const DataType& x = backStack.top();
+            if(frontStack.empty())
+                frontStack.push(Entry{x, x});
+            else
+                frontStack.push(Entry{x, op(x, frontStack.top().agg)});
+            backStack.pop();
+        }
+    }
+
+  public:
+
+    // default constructor
+    explicit MyTwoStackQueue(const Op& o = Op()) :
+        backAgg{},
+        op{o}
+    {
+        ;
+    }
+
+    // inserts x at the back of the queue
+    void enqueue(const DataType& x)
+    {
+        backAgg = backStack.empty() ? x : op(backAgg, x);
+        backStack.push(x);
+    }
+
+    // removes the oldest element of the queue
+    void dequeue()
+    {
+        if(frontStack.empty())
+            flip();
+        if(!frontStack.empty())
+            frontStack.pop();
+    }
+
+    // returns the oldest element of the queue; the queue must not be empty
+    const DataType& front()
+    {
+        if(frontStack.empty())
+            flip();
+        return frontStack.top().value;
+    }
+
+    // returns Op folded over the queue from oldest to newest; the queue must not be empty
+    DataType aggregate() const
+    {
+        if(frontStack.empty())
+            return backAgg;
+        if(backStack.empty())
+            return frontStack.top().agg;
+        return op(frontStack.top().agg, backAgg);
+    }
+
+    // checks whether the queue is empty
+    bool empty() const
+    {
+        return frontStack.empty() && backStack.empty();
+    }
+
+    // returns the number of elements in the queue
+    size_t size() const
+    {
+        return frontStack.size() + backStack.size();
+    }
+
+};
+
+#endif // __MYSLIDINGWINDOW_H__
@@ -0,0 +1,174 @@
+#ifndef __MYSPLITBINARYHEAP_H__
+#define __MYSPLITBINARYHEAP_H__
+
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+#include "MyVector_e259o067.h"
+#include "MyDaryHeapLayout_e259o067.h"
+
+// KeyType should be comparable (<, >, ==, >=, <= operators implemented)
+
+// MyBinaryHeap with the key and the payload of every element stored apart (hot/cold split)
+// only compact (key, 32-bit slot) pairs are sifted; payloads stay put in a side array and are
+// touched once on enqueue and once on dequeue, so the cost of a sift depends on the key size alone
+// freed payload slots are reused, so the side array does not grow past the peak heap size
+// like MyBinaryHeap, this is a max-heap in a 0-based array with Arity (2, 4 or 8) children per node,
+// stored and sifted by MyDaryHeapLayout
+
+template <typename KeyType, typename PayloadType, size_t Arity = 2>
+class MySplitBinaryHeap
+{
+    static_assert(Arity == 2 || Arity == 4 || Arity == 8, "MySplitBinaryHeap supports arity 2, 4 or 8");
+
+    typedef MyDaryHeapLayout<Arity> Layout;
+
+  private:
+    struct Entry
+    {
+        KeyType key;
+        uint32_t slot;      // the position of the payload in payloads
+    };
+
+    MyDaryHeapArray<Entry, Arity> heap; // the sifted (key, slot) pairs
+    MyVector<PayloadType> payloads;     // the payloads; they never move while queued
+    MyVector<uint32_t> freeSlots;       // payload slots available for reuse
+
+    // moves the entry at the pth position of the array up
+    void percolateUp(const size_t p)
+    {
+        Layout::percolateUp(heap, p,
+            [](const Entry& x, const Entry& y){ return x.key > y.key; },
+            [this](const size_t i, Entry && x){ heap[i] = std::move(x); });
+    }
+
+    // moves the entry at the pth position of the array down
+    void percolateDown(const size_t p)
+    {
+        Layout::percolateDown(heap, p, heap.size(),
+            [](const Entry& x, const Entry& y){ return x.key > y.key; },
+            [this](const size_t i, Entry && x){ heap[i] = std::move(x); });
+    }
+
+    // returns a payload slot holding payload
+    template <typename P>
+    uint32_t store(P && payload)
+    {
+        if(!freeSlots.empty()){
+            uint32_t s = freeSlots.back();
+            freeSlots.pop_back();
+            payloads[s] = std::forward<P>(payload);
+            return s;
+        }
+        if(payloads.size() >= UINT32_MAX)
+            throw std::length_error("MySplitBinaryHeap: too many payloads for a 32-bit slot");
+        payloads.push_back(std::forward<P>(payload));
+        return (uint32_t)(payloads.size() - 1);
+    }
+
+    // inserts key with the payload in slot s
+    void insert(const KeyType& key, const uint32_t s)
+    {
+        heap.push_back(Entry{key, s});
+        percolateUp(heap.size() - 1);
+    }
+
+    // removes the front entry and releases its payload slot
+    void removeFront()
+    {
+        uint32_t s = heap[0].slot;
+        payloads[s] = PayloadType();
+        freeSlots.push_back(s);
+        heap[0] = std::move(heap[heap.size() - 1]);
+        heap.pop_back();
+        if(!heap.empty()) percolateDown(0);
+    }
+
+  public:
+
+    // default constructor
+    MySplitBinaryHeap()
+    {
+        ;
+    }
+
+    // inserts a key with its payload (copy)
+    void enqueue(const KeyType& key, const PayloadType& payload)
+    {
+        insert(key, store(payload));
+    }
+
+    // inserts a key with its payload (move)
+    void enqueue(const KeyType& key, PayloadType && payload)
+    {
+        insert(key, store(std::move(payload)));
+    }
+
+    // accesses the highest-priority key
+    const KeyType& frontKey() const
+    {
+        return heap[0].key;
+    }
+
+    // accesses the payload of the highest-priority key
+    PayloadType& frontPayload()
+    {
+        return payloads[heap[0].slot];
+    }
+
+    const PayloadType& frontPayload() const
+    {
+        return payloads[heap[0].slot];
+    }
+
+    // deletes the element with the highest priority
+    void dequeue()
+    {
+        if(empty()) return;
+        removeFront();
+    }
+
+    // deletes the element with the highest priority and moves its payload into out
+    // returns false if the heap is empty
+    bool dequeue(PayloadType& out)
+    {
+        if(empty()) return false;
+        out = std::move(payloads[heap[0].slot]);
+        removeFront();
+        return true;
+    }
+
+    // verifies whether the array satisfies the heap property
+    bool verifyHeapProperty(void) const
+    {
+        for(size_t i = 1; i < heap.size(); ++i){
+            if(heap[i].key > heap[Layout::parentOf(i)].key)
+                return false;
+        }
+        return true;
+    }
+
+    // checks whether the heap is empty
+    bool empty() const
+    {
+        return heap.size() == 0;
+    }
+
+    // returns the size of the heap
+    size_t size() const
+    {
+        return heap.size();
+    }
+
+    // removes all data elements from the heap
+    void clear()
+    {
+        heap = MyDaryHeapArray<Entry, Arity>();
+        payloads = MyVector<PayloadType>();
+        freeSlots.resize(0);
+    }
+
+};
+
+#endif // __MYSPLITBINARYHEAP_H__
@@ -4,7 +4,7 @@
 #include <iostream>
 #include <algorithm>
 
-#include "MyVector.h"
+#include "MyVector_e259o067.h"
 
 template <typename DataType>
 class MyStack : private MyVector<DataType>
@@ -0,0 +1,65 @@
+#ifndef __MYSTATICSTACK_H__
+#define __MYSTATICSTACK_H__
+
+#include <utility>
+
+#include "MyStaticVector_e259o067.h"
+
+// stack with N elements of in-object storage; see MyStaticVector for the overflow policies
+
+template <typename DataType, size_t N, OverflowPolicyType Policy = ThrowOnOverflow>
+class MyStaticStack : private MyStaticVector<DataType, N, Policy>
+{
+  public:
+
+    // default constructor
+    constexpr MyStaticStack()
+    {
+
+    }
+
+    // insert x to the stack
+    constexpr void push(const DataType & x)
+    {
+        MyStaticVector<DataType, N, Policy>::push_back(x);
+    }
+
+    // insert x to the stack
+    constexpr void push(DataType && x)
+    {
+        MyStaticVector<DataType, N, Policy>::push_back(std::move(x));
+    }
+
+    // remove the last element from the stack
+    constexpr void pop(void)
+    {
+        MyStaticVector<DataType, N, Policy>::pop_back();
+    }
+
+    // access the last element of the stack
+    constexpr const DataType & top(void) const
+    {
+        return MyStaticVector<DataType, N, Policy>::back();
+    }
+
+    // check if the stack is empty; return TRUE is empty; FALSE otherwise
+    constexpr bool empty(void) const
+    {
+        return MyStaticVector<DataType, N, Policy>::empty();
+    }
+
+    // access the size of the stack
+    constexpr size_t size() const
+    {
+        return MyStaticVector<DataType, N, Policy>::size();
+    }
+
+    // access the capacity of the stack
+    constexpr size_t capacity(void) const
+    {
+        return MyStaticVector<DataType, N, Policy>::capacity();
+    }
+
+};
+
+#endif // __MYSTATICSTACK_H__
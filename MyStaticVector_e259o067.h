@@ -0,0 +1,242 @@
+#ifndef __MYSTATICVECTOR_H__
+#define __MYSTATICVECTOR_H__
+
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+// what a fixed-capacity container does when an insertion would exceed its capacity
+enum OverflowPolicyType
+{
+    ThrowOnOverflow,    // throw std::length_error
+    SpillToHeap         // move the elements to a heap array and keep growing
+};
+
+// vector with N elements of in-object storage; no allocation happens while the size stays within N
+// all operations are constexpr (C++20), so the container can be used in constant expressions
+// and as a plain stack variable
+// DataType should be default constructible, like MyVector
+
+template <typename DataType, size_t N, OverflowPolicyType Policy = ThrowOnOverflow>
+class MyStaticVector
+{
+    static_assert(N > 0, "MyStaticVector requires a positive capacity");
+
+  private:
+    DataType inlineData[N]{};       // the in-object storage
+    DataType* heapData;             // the spilled storage; nullptr while the elements are inline
+    size_t theSize;                 // the number of data elements the vector is currently holding
+    size_t theCapacity;             // N while inline; the heap array length once spilled
+
+    // handles an insertion into a full vector
+    constexpr void overflow()
+    {
+        if constexpr (Policy == ThrowOnOverflow)
+            throw std::length_error("MyStaticVector: capacity exceeded");
+        else
+            reserve(2*theCapacity);
+    }
+
+  public:
+
+    // default constructor
+    constexpr MyStaticVector() :
+        heapData{nullptr},
+        theSize{0},
+        theCapacity{N}
+    {
+        ;
+    }
+
+    // copy constructor
+    constexpr MyStaticVector(const MyStaticVector& rhs) :
+        heapData{nullptr},
+        theSize{0},
+        theCapacity{N}
+    {
+        reserve(rhs.theSize);
+        for(size_t i=0; i<rhs.theSize; ++i)
+            data()[i] = rhs[i];
+        theSize = rhs.theSize;
+    }
+
+    // move constructor; steals the heap array if there is one
+    constexpr MyStaticVector(MyStaticVector&& rhs) :
+        heapData{rhs.heapData},
+        theSize{rhs.theSize},
+        theCapacity{rhs.theCapacity}
+    {
+        if(heapData == nullptr)
+            for(size_t i=0; i<theSize; ++i)
+                inlineData[i] = std::move(rhs.inlineData[i]);
+        rhs.heapData = nullptr;
+        rhs.theSize = 0;
+        rhs.theCapacity = N;
+    }
+
+    // destructor
+    constexpr ~MyStaticVector()
+    {
+        delete [] heapData;
+    }
+
+    // copy assignment
+    constexpr MyStaticVector& operator=(const MyStaticVector& rhs)
+    {
+        if(this != &rhs){
+            theSize = 0;
+            reserve(rhs.theSize);
+            for(size_t i=0; i<rhs.theSize; ++i)
+                data()[i] = rhs[i];
+            theSize = rhs.theSize;
+        }
+        return *this;
+    }
+
+    // move assignment
+    constexpr MyStaticVector& operator=(MyStaticVector&& rhs)
+    {
+        if(this != &rhs){
+            delete [] heapData;
+            heapData = rhs.heapData;
+            theSize = rhs.theSize;
+            theCapacity = rhs.theCapacity;
+            if(heapData == nullptr)
+                for(size_t i=0; i<theSize; ++i)
+                    inlineData[i] = std::move(rhs.inlineData[i]);
+            rhs.heapData = nullptr;
+            rhs.theSize = 0;
+            rhs.theCapacity = N;
+        }
+        return *this;
+    }
+
+    // makes room for newCapacity elements; only possible under SpillToHeap
+    constexpr void reserve(size_t newCapacity)
+    {
+        if(newCapacity <= theCapacity)
+            return;
+        if constexpr (Policy == ThrowOnOverflow)
+            throw std::length_error("MyStaticVector: capacity exceeded");
+        else{
+            DataType* newArray = new DataType[newCapacity];
+            for(size_t i=0; i<theSize; ++i)
+                newArray[i] = std::move(data()[i]);
+            delete [] heapData;
+            heapData = newArray;
+            theCapacity = newCapacity;
+        }
+    }
+
+    // returns the address of the first element
+    constexpr DataType* data()
+    {
+        return heapData != nullptr ? heapData : inlineData;
+    }
+
+    constexpr const DataType* data() const
+    {
+        return heapData != nullptr ? heapData : inlineData;
+    }
+
+    // data access operator (without bound checking)
+    constexpr DataType& operator[](size_t index)
+    {
+        return data()[index];
+    }
+
+    constexpr const DataType& operator[](size_t index) const
+    {
+        return data()[index];
+    }
+
+    // checks if the vector is empty
+    constexpr bool empty() const
+    {
+        return theSize == 0;
+    }
+
+    // returns the size of the vector
+    constexpr size_t size() const
+    {
+        return theSize;
+    }
+
+    // returns the capacity of the vector
+    constexpr size_t capacity() const
+    {
+        return theCapacity;
+    }
+
+    // checks whether the elements have moved to the heap
+    constexpr bool spilled() const
+    {
+        return heapData != nullptr;
+    }
+
+    // insert a data element to the end of the vector (copy)
+    constexpr void push_back(const DataType& x)
+    {
+        if(theSize == theCapacity)
+            overflow();
+        data()[theSize++] = x;
+    }
+
+    // insert a data element to the end of the vector (move)
+    constexpr void push_back(DataType&& x)
+    {
+        if(theSize == theCapacity)
+            overflow();
+        data()[theSize++] = std::move(x);
+    }
+
+    // remove the last data element from the vector
+    constexpr void pop_back()
+    {
+        --theSize;
+    }
+
+    // returns the last data element of the vector
+    constexpr DataType& back()
+    {
+        return data()[theSize-1];
+    }
+
+    constexpr const DataType& back() const
+    {
+        return data()[theSize-1];
+    }
+
+    // removes all data elements; spilled storage is kept
+    constexpr void clear()
+    {
+        theSize = 0;
+    }
+
+    // iterator implementation
+    typedef DataType* iterator;
+    typedef const DataType* const_iterator;
+
+    constexpr iterator begin()
+    {
+        return data();
+    }
+
+    constexpr const_iterator begin() const
+    {
+        return data();
+    }
+
+    constexpr iterator end()
+    {
+        return data() + theSize;
+    }
+
+    constexpr const_iterator end() const
+    {
+        return data() + theSize;
+    }
+
+};
+
+#endif // __MYSTATICVECTOR_H__
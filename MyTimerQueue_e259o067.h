@@ -0,0 +1,293 @@
+#ifndef __MYTIMERQUEUE_H__
+#define __MYTIMERQUEUE_H__
+
+#include <cstdint>
+#include <functional>
+#include <utility>
+
+#include "MyIndexedBinaryHeap_e259o067.h"
+#include "MyVector_e259o067.h"
+
+// timer/deadline scheduler with O(1) cancellation for near-term timers and O(log n) for the rest
+// time is an unsigned tick count in whatever unit the caller chooses
+// near-term timers live in a two-level hierarchical timing wheel:
+//   level 0   256 slots of one tick each
+//   level 1    64 slots of 256 ticks each; a slot is cascaded into level 0 when its block begins
+// timers beyond the wheel's horizon (about 16K ticks) wait in a MyIndexedBinaryHeap ordered by
+// deadline and move into the wheel as the horizon reaches them
+// cancel and reschedule unlink the timer directly, so cancelled timers leave no tombstones behind
+// runExpired(now) fires every timer whose deadline is at or before now, in deadline order per tick
+
+class MyTimerQueue
+{
+  public:
+    typedef uint64_t TimerId;                   // 0 never names a timer
+    typedef std::function<void()> Callback;
+
+  private:
+    static const size_t L0_BITS = 8;
+    static const size_t L1_BITS = 6;
+    static const size_t L0_SLOTS = size_t(1) << L0_BITS;
+    static const size_t L1_SLOTS = size_t(1) << L1_BITS;
+    static const size_t DUE_LIST = L0_SLOTS + L1_SLOTS;    // timers already due when scheduled
+    static const size_t IN_HEAP = DUE_LIST + 1;
+    static const size_t NOT_QUEUED = DUE_LIST + 2;
+    static constexpr size_t NIL = (size_t)-1;
+
+    struct Timer
+    {
+        uint64_t deadline;
+        Callback callback;
+        uint32_t generation;    // bumped whenever the record is freed, so stale ids are rejected
+        size_t list;            // a wheel slot, DUE_LIST, IN_HEAP or NOT_QUEUED
+        size_t prev;            // neighbours in the list
+        size_t next;
+        uint64_t heapHandle;    // the handle in farTimers when IN_HEAP
+    };
+
+    // heap key: the earliest deadline has the highest priority in the max-heap
+    struct HeapKey
+    {
+        uint64_t deadline;
+        size_t timer;
+
+        bool operator>(const HeapKey& rhs) const
+        {
+            return deadline < rhs.deadline;
+        }
+
+        bool operator<(const HeapKey& rhs) const
+        {
+            return deadline > rhs.deadline;
+        }
+    };
+
+    MyVector<Timer> timers;                 // the timer records
+    MyVector<size_t> freeTimers;            // records available for reuse
+    MyVector<size_t> heads;                 // the first timer of every list
+    MyIndexedBinaryHeap<HeapKey> farTimers; // timers beyond the wheel's horizon
+    uint64_t current;                       // every timer with deadline <= current has fired
+    size_t inWheel;                         // the number of timers in the wheel lists
+    size_t theSize;                         // the number of pending timers
+
+    static uint64_t block(const uint64_t t)
+    {
+        return t >> L0_BITS;
+    }
+
+    // links timer i at the front of list l
+    void link(const size_t i, const size_t l)
+    {
+        Timer& t = timers[i];
+        t.list = l;
+        t.prev = NIL;
+        t.next = heads[l];
+        if(heads[l] != NIL)
+            timers[heads[l]].prev = i;
+        heads[l] = i;
+        ++inWheel;
+    }
+
+    // removes timer i from whatever holds it
+    void unlink(const size_t i)
+    {
+        Timer& t = timers[i];
+        if(t.list == IN_HEAP)
+            farTimers.erase(t.heapHandle);
+        else if(t.list != NOT_QUEUED){
+            if(t.prev != NIL)
+                timers[t.prev].next = t.next;
+            else
+                heads[t.list] = t.next;
+            if(t.next != NIL)
+                timers[t.next].prev = t.prev;
+            --inWheel;
+        }
+        t.list = NOT_QUEUED;
+    }
+
+    // checks whether a deadline is close enough to be kept in the wheel
+    bool fitsWheel(const uint64_t d) const
+    {
+        return block(d) - block(current) < L1_SLOTS;
+    }
+
+    // puts timer i where its deadline belongs, relative to current:
+    // level 0 if it falls in the current block, level 1 if it falls in one of the next 63 blocks
+    void place(const size_t i)
+    {
+        const uint64_t d = timers[i].deadline;
+        if(d <= current)
+            link(i, DUE_LIST);
+        else if(block(d) == block(current))
+            link(i, d & (L0_SLOTS - 1));
+        else if(fitsWheel(d))
+            link(i, L0_SLOTS + (block(d) & (L1_SLOTS - 1)));
+        else{
+            timers[i].list = IN_HEAP;
+            timers[i].heapHandle = farTimers.enqueue(HeapKey{d, i});
+        }
+    }
+
+    // releases the record of timer i
+    void release(const size_t i)
+    {
+        timers[i].callback = nullptr;
+        ++timers[i].generation;
+        freeTimers.push_back(i);
+        --theSize;
+    }
+
+    // decodes an id; returns NIL if it does not name a pending timer
+    size_t lookup(const TimerId id) const
+    {
+        size_t i = (size_t)(id & 0xffffffffu) - 1;
+        uint32_t gen = (uint32_t)(id >> 32);
+        if(id == 0 || i >= timers.size())
+            return NIL;
+        if(timers[i].generation != gen || timers[i].list == NOT_QUEUED)
+            return NIL;
+        return i;
+    }
+
+    // fires every timer in list l; callbacks may schedule or cancel other timers
+    size_t fireList(const size_t l)
+    {
+        size_t fired = 0;
+        while(heads[l] != NIL){
+            size_t i = heads[l];
+            unlink(i);
+            Callback cb = std::move(timers[i].callback);
+            release(i);
+            cb();
+            ++fired;
+        }
+        return fired;
+    }
+
+    // moves the timers of the level-1 slot for the block starting at current into level 0,
+    // and the heap timers that now fit into the wheel
+    void cascade()
+    {
+        const size_t l = L0_SLOTS + (block(current) & (L1_SLOTS - 1));
+        while(heads[l] != NIL){
+            size_t i = heads[l];
+            unlink(i);
+            place(i);
+        }
+        while(!farTimers.empty() && fitsWheel(farTimers.front().deadline)){
+            size_t i = farTimers.front().timer;
+            farTimers.dequeue();
+            timers[i].list = NOT_QUEUED;
+            place(i);
+        }
+    }
+
+  public:
+
+    // constructor; start is the initial time
+    explicit MyTimerQueue(const uint64_t start = 0) :
+        heads(L0_SLOTS + L1_SLOTS + 1),
+        current{start},
+        inWheel{0},
+        theSize{0}
+    {
+        for(size_t l = 0; l < heads.size(); ++l)
+            heads[l] = NIL;
+    }
+
+    // schedules cb to run at deadline; returns the id of the timer
+    TimerId schedule(const uint64_t deadline, Callback cb)
+    {
+        size_t i;
+        if(!freeTimers.empty()){
+            i = freeTimers.back();
+            freeTimers.pop_back();
+        }
+        else{
+            timers.push_back(Timer{0, nullptr, 1, NOT_QUEUED, NIL, NIL, 0});
+            i = timers.size() - 1;
+        }
+        timers[i].deadline = deadline;
+        timers[i].callback = std::move(cb);
+        place(i);
+        ++theSize;
+        return ((TimerId)timers[i].generation << 32) | (TimerId)(i + 1);
+    }
+
+    // cancels a pending timer; returns false if id does not name one
+    bool cancel(const TimerId id)
+    {
+        size_t i = lookup(id);
+        if(i == NIL)
+            return false;
+        unlink(i);
+        release(i);
+        return true;
+    }
+
+    // moves a pending timer to a new deadline; the id stays valid
+    // returns false if id does not name a pending timer
+    bool reschedule(const TimerId id, const uint64_t deadline)
+    {
+        size_t i = lookup(id);
+        if(i == NIL)
+            return false;
+        unlink(i);
+        timers[i].deadline = deadline;
+        place(i);
+        return true;
+    }
+
+    // advances the time to now and fires every timer with deadline <= now
+    // returns the number of timers fired
+    size_t runExpired(const uint64_t now)
+    {
+        size_t fired = fireList(DUE_LIST);
+        while(current < now){
+            if(inWheel == 0){
+                // nothing in the wheel: jump to the earlier of now and the next heap deadline
+                uint64_t target = now;
+                if(!farTimers.empty() && farTimers.front().deadline < target)
+                    target = farTimers.front().deadline;
+                current = target;
+                cascade();
+            }
+            else{
+                ++current;
+                if((current & (L0_SLOTS - 1)) == 0)
+                    cascade();
+            }
+            fired += fireList(current & (L0_SLOTS - 1));
+            fired += fireList(DUE_LIST);
+        }
+        return fired;
+    }
+
+    // returns the time up to which all timers have fired
+    uint64_t currentTime() const
+    {
+        return current;
+    }
+
+    // checks whether a timer is pending
+    bool pending(const TimerId id) const
+    {
+        return lookup(id) != NIL;
+    }
+
+    // returns the number of pending timers
+    size_t size() const
+    {
+        return theSize;
+    }
+
+    // checks whether no timer is pending
+    bool empty() const
+    {
+        return theSize == 0;
+    }
+
+};
+
+#endif // __MYTIMERQUEUE_H__
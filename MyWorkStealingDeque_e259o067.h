@@ -0,0 +1,160 @@
+#ifndef __MYWORKSTEALINGDEQUE_H__
+#define __MYWORKSTEALINGDEQUE_H__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// Chase-Lev work-stealing deque (with the C11 memory orderings of Le et al.)
+// the owner thread uses it like MyStack: push and pop work on the bottom end
+// any other thread may steal from the top end
+// DataType must be trivially copyable (typically a pointer to a task)
+// the ring grows on demand; retired rings are kept until destruction because a thief may still read them
+
+template <typename DataType>
+class MyWorkStealingDeque
+{
+    static_assert(std::is_trivially_copyable<DataType>::value, "MyWorkStealingDeque requires a trivially copyable type");
+
+  private:
+    static const size_t CACHE_LINE = 64;
+
+    struct Ring
+    {
+        int64_t capacity;               // a power of two
+        std::atomic<DataType>* slots;
+        Ring* retired;                  // the previous, smaller ring
+
+        explicit Ring(const int64_t cap, Ring* prev = nullptr) :
+            capacity{cap},
+            slots{new std::atomic<DataType>[cap]},
+            retired{prev}
+        {
+            ;
+        }
+
+        ~Ring()
+        {
+            delete [] slots;
+        }
+
+        DataType get(const int64_t i) const
+        {
+            return slots[i & (capacity - 1)].load(std::memory_order_relaxed);
+        }
+
+        void put(const int64_t i, const DataType x)
+        {
+            slots[i & (capacity - 1)].store(x, std::memory_order_relaxed);
+        }
+    };
+
+    alignas(CACHE_LINE) std::atomic<int64_t> top;       // the next position thieves steal from
+    alignas(CACHE_LINE) std::atomic<int64_t> bottom;    // the next position the owner pushes to
+    std::atomic<Ring*> ring;
+
+    // doubles the ring; only called by the owner
+    Ring* grow(Ring* old, const int64_t b, const int64_t t)
+    {
+        Ring* bigger = new Ring(old->capacity * 2, old);
+        for(int64_t i = t; i < b; ++i)
+            bigger->put(i, old->get(i));
+        ring.store(bigger, std::memory_order_release);
+        return bigger;
+    }
+
+  public:
+
+    // constructor; the initial capacity is rounded up to a power of two
+    explicit MyWorkStealingDeque(size_t initCapacity = 64) :
+        top{0},
+        bottom{0}
+    {
+        int64_t cap = 2;
+        while(cap < (int64_t)initCapacity)
+            cap <<= 1;
+        ring.store(new Ring(cap), std::memory_order_relaxed);
+    }
+
+    // the deque is shared by address between threads; copying or moving it is not supported
+    MyWorkStealingDeque(const MyWorkStealingDeque& rhs) = delete;
+    MyWorkStealingDeque& operator=(const MyWorkStealingDeque& rhs) = delete;
+
+    // destructor
+    ~MyWorkStealingDeque()
+    {
+        Ring* r = ring.load(std::memory_order_relaxed);
+        while(r != nullptr){
+            Ring* prev = r->retired;
+            delete r;
+            r = prev;
+        }
+    }
+
+    // owner: inserts x at the bottom
+    void push(const DataType x)
+    {
+        int64_t b = bottom.load(std::memory_order_relaxed);
+        int64_t t = top.load(std::memory_order_acquire);
+        Ring* r = ring.load(std::memory_order_relaxed);
+        if(b - t > r->capacity - 1)
+            r = grow(r, b, t);
+        r->put(b, x);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+    // owner: removes the bottom element into x; returns false if the deque is empty
+    bool pop(DataType& x)
+    {
+        int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        Ring* r = ring.load(std::memory_order_relaxed);
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top.load(std::memory_order_relaxed);
+        if(t > b){
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+        x = r->get(b);
+        if(t == b){
+            // the last element; race the thieves for it
+            bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    // any thread: removes the top element into x; returns false if the deque is empty
+    // or another thread won the race for the element
+    bool steal(DataType& x)
+    {
+        int64_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = bottom.load(std::memory_order_acquire);
+        if(t >= b)
+            return false;
+        Ring* r = ring.load(std::memory_order_acquire);
+        x = r->get(t);
+        return top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    }
+
+    // returns the approximate number of elements
+    size_t size() const
+    {
+        int64_t b = bottom.load(std::memory_order_relaxed);
+        int64_t t = top.load(std::memory_order_relaxed);
+        return (b > t) ? (size_t)(b - t) : 0;
+    }
+
+    // checks whether the deque is (approximately) empty
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+};
+
+#endif // __MYWORKSTEALINGDEQUE_H__